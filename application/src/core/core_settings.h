@@ -0,0 +1,36 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+// Réglages du coeur du jeu (règles et IA), partagés avec les outils en ligne de commande.
+// Le coeur n'utilise de la SDL que les threads, les opérations atomiques et les horloges :
+// il ne dépend ni de la vidéo, ni de SDL_image, ni de SDL_ttf (voir settings.h pour l'application).
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <SDL3/SDL_atomic.h>
+#include <SDL3/SDL_cpuinfo.h>
+#include <SDL3/SDL_mutex.h>
+#include <SDL3/SDL_thread.h>
+#include <SDL3/SDL_timer.h>
+
+#ifdef _MSC_VER
+#  define INLINE inline
+#else
+#  define INLINE static inline
+#endif
+
+#define AssertNew(ptr) { if (ptr == NULL) { assert(false); abort(); } }
+
+#define DEBUG 0
@@ -5,6 +5,9 @@
 */
 
 #include "core/quoridor_core.h"
+#include "core/quoridor_ai.h"
+#include "core/quoridor_tt.h"
+#include "core/quoridor_mcts.h"
 #include "core/utils.h"
 #include <limits.h>
 
@@ -12,9 +15,6 @@
 #define DEBUG 0
 #endif
 
-#define DIJKSTRA 0
-#define BFS 1
-
 #define MAX_NUM_WALL 130
 #define MAX_MOVES_AVAILABLE 5
 
@@ -30,24 +30,27 @@ typedef struct QuoridorPath
     int size;
 } QuoridorPath;
 
-typedef struct Data
+/// @brief Logarithme en base 2 du nombre de buckets de la table de transposition (4 Mo).
+#define AI_TT_LOG2_BUCKET_COUNT 16
+
+/// @brief Données conservées par l'IA d'un joueur entre deux recherches.
+typedef struct AIData
 {
-    QuoridorPath myPath;
-    QuoridorPath otherPath;
-    bool upToDate;
-} Data;
+    /// @brief Table de transposition partagée par les recherches successives.
+    QuoridorTT *table;
 
-void QuoridorCore_getShortestPath(QuoridorCore *self, int playerID, QuoridorPos *path, int *size);
+    /// @brief Arbre de la recherche Monte-Carlo, réutilisé d'un tour à l'autre.
+    /// Il est créé lors de la première recherche Monte-Carlo.
+    MCTSTree *mcts;
 
-static void aiData_update(Data *self, QuoridorCore *core, int playerID)
-{
-    if (!self && self->upToDate)
-        return;
+    /// @brief Cache des analyses utilisé lorsque les paramètres de la recherche n'en donnent pas
+    /// (voir AIData_setCache()). Il n'appartient pas aux données de l'IA.
+    AICache *cache;
 
-    QuoridorCore_getShortestPath(core, playerID, self->myPath.tiles, &(self->myPath.size));
-    QuoridorCore_getShortestPath(core, playerID ^ 1, self->otherPath.tiles, &(self->otherPath.size));
-    self->upToDate = true;
-}
+    /// @brief Livre d'ouvertures utilisé lorsque les paramètres de la recherche n'en donnent pas
+    /// (voir AIData_setBook()). Il n'appartient pas aux données de l'IA.
+    const QuoridorBook *book;
+} AIData;
 
 /// @brief Indique si a est compris entre lowlimit et highlimit
 /// @brief fonction rajoutée par Samuel
@@ -62,208 +65,242 @@ static bool isBetween(int a, int lowlimit, int highlimit)
 
 void *AIData_create(QuoridorCore *core)
 {
-    /*Data* data = (Data*)calloc(1, sizeof(Data));
-    return data;*/
+    AIData *self = (AIData *)calloc(1, sizeof(AIData));
+    AssertNew(self);
+
+    self->table = QuoridorTT_create(AI_TT_LOG2_BUCKET_COUNT);
+
+    return self;
 }
 
 void AIData_destroy(void *self)
 {
-    /*if (!self) return;
-    free(self);*/
+    if (!self) return;
+    AIData *data = (AIData *)self;
+    QuoridorTT_destroy(data->table);
+    MCTSTree_destroy(data->mcts);
+    free(data);
 }
 
-void AIData_reset(void *self)
+/// @brief Renvoie la table de transposition des données de l'IA.
+/// @param self Pointeur vers les données de l'IA (peut être NULL).
+/// @return La table de transposition, ou NULL si l'IA n'a pas de données.
+static QuoridorTT *AIData_getTable(void *self)
 {
-    /*if (!self) return;
-    Data* data = self;
-    data->upToDate = false;*/
+    return (self) ? ((AIData *)self)->table : NULL;
 }
 
-#if DIJKSTRA
-int Dijkstra_getNextNode(int *pred, unsigned int *dist, bool *explored, int size)
+void AIData_reset(void *self)
 {
-    unsigned int minDist = UINT_MAX;
-    int posMinDist = -1;
+    if (!self) return;
+    AIData *data = (AIData *)self;
+    QuoridorTT_clear(data->table);
+    if (data->mcts) MCTSTree_clear(data->mcts);
+}
 
-    for (int i = 0; i < size; i++)
-    {
-        if (dist[i] < minDist && !explored[i])
-        {
-            minDist = dist[i];
-            posMinDist = i;
-        }
-    }
-    return posMinDist;
+void AIData_setCache(void *self, AICache *cache)
+{
+    assert(self && "The AIData must be created");
+    ((AIData *)self)->cache = cache;
 }
 
-void QuoridorCore_getShortestPath(QuoridorCore *self, int playerID, QuoridorPos *path, int *size)
+void AIData_setBook(void *self, const QuoridorBook *book)
 {
-    int tileNumber = self->gridSize * self->gridSize;
+    assert(self && "The AIData must be created");
+    ((AIData *)self)->book = book;
+}
 
-    int pred[MAX_GRID_SIZE * MAX_GRID_SIZE];
-    memset(pred, -1, sizeof(pred));
-    unsigned int dist[MAX_GRID_SIZE * MAX_GRID_SIZE];
-    memset(dist, UINT_MAX, sizeof(dist));
+/// @brief Profondeur maximale atteinte par l'approfondissement itératif.
+#define AI_MAX_DEPTH 32
 
-    bool explored[MAX_GRID_SIZE * MAX_GRID_SIZE] = {0};
+/// @brief Nombre maximal de threads d'une recherche.
+#define AI_MAX_THREADS 64
 
-    int pos = self->positions[playerID].i * self->gridSize + self->positions[playerID].j;
-    dist[pos] = 0;
+/// @brief Nombre de noeuds visités entre deux lectures de l'horloge et du drapeau d'arrêt.
+#define AI_CLOCK_CHECK_INTERVAL 64
 
-    int jTarget = (playerID == 0) ? self->gridSize - 1 : 0;
+/// @brief Clé combinée (ou exclusif) avec celle des positions lorsque le joueur 1 cherche son coup.
+/// Les scores de la table de transposition sont ceux de l'évaluation du joueur à la racine,
+/// qui n'est pas antisymétrique : les entrées d'une recherche du joueur 0 ne valent pas pour le joueur 1.
+#define AI_TT_ROOT_PLAYER_KEY 0xD6E8FEB86659FD93ULL
 
-    int u = Dijkstra_getNextNode(pred, dist, explored, tileNumber);
-    int i, j;
-    while (u != -1)
-    {
-        i = u / self->gridSize;
-        j = u % self->gridSize;
-        explored[u] = true;
+typedef struct AIYBWC AIYBWC;
+typedef struct AISplitPoint AISplitPoint;
 
-        if (!QuoridorCore_hasWallAbove(self, i, j))
-        {
-            if (dist[u] + 1 < dist[u - self->gridSize])
-            {
-                pred[u - self->gridSize] = u;
-                dist[u - self->gridSize] = dist[u] + 1;
-            }
-        }
-        if (!QuoridorCore_hasWallBelow(self, i, j))
-        {
-            if (dist[u] + 1 < dist[u + self->gridSize])
-            {
-                pred[u + self->gridSize] = u;
-                dist[u + self->gridSize] = dist[u] + 1;
-            }
-        }
-        if (!QuoridorCore_hasWallLeft(self, i, j))
-        {
-            if (dist[u] + 1 < dist[u - 1])
-            {
-                pred[u - 1] = u;
-                dist[u - 1] = dist[u] + 1;
-            }
-        }
-        if (!QuoridorCore_hasWallRight(self, i, j))
-        {
-            if (dist[u] + 1 < dist[u + 1])
-            {
-                pred[u + 1] = u;
-                dist[u + 1] = dist[u] + 1;
-            }
-        }
+/// @brief Contexte d'une recherche, partagé par tous les noeuds de l'arbre.
+typedef struct AISearch
+{
+    /// @brief Table de transposition (peut être NULL).
+    QuoridorTT *table;
 
-        if (j == jTarget)
-            break;
-        u = Dijkstra_getNextNode(pred, dist, explored, tileNumber);
-    }
+    /// @brief Clé combinée avec celle des positions dans la table de transposition
+    /// (0 ou AI_TT_ROOT_PLAYER_KEY selon le joueur à la racine).
+    uint64_t rootKey;
 
-    int minIndex = i * self->gridSize + j;
-    *size = dist[minIndex] + 1;
+    /// @brief Meilleur coup de l'itération précédente, exploré en premier à la racine.
+    QuoridorTurn rootTurn;
 
-    path[0].i = i;
-    path[0].j = j;
+    /// @brief Instant (en millisecondes, cf. SDL_GetTicks()) auquel la recherche doit s'arrêter.
+    /// Vaut 0 si la recherche n'est pas limitée en temps.
+    Uint64 deadline;
 
-    for (int k = 1; k < *size; k++)
-    {
-        path[k].i = pred[minIndex] / self->gridSize;
-        path[k].j = pred[minIndex] % self->gridSize;
+    /// @brief Drapeau d'arrêt partagé avec un autre thread (peut être NULL).
+    SDL_AtomicInt *stopFlag;
 
-        minIndex = pred[minIndex];
-    }
-}
-#endif
-#if BFS
-void QuoridorCore_getShortestPath(QuoridorCore *self, int playerID, QuoridorPos *path, int *size)
-{
-    int gridSize = self->gridSize;
+    /// @brief Nombre de threads utilisés pour explorer les fils de la racine.
+    int threadCount;
 
-    int targetJ = (playerID == 0) ? gridSize - 1 : 0;
+    /// @brief Indice du thread auxiliaire (Lazy SMP), 0 pour le thread principal.
+    /// Les threads auxiliaires décalent l'ordre des fils pour explorer l'arbre différemment.
+    int helperID;
 
-    bool explored[MAX_GRID_SIZE][MAX_GRID_SIZE] = {0};
+    /// @brief État du générateur pseudo-aléatoire propre à la recherche.
+    /// La fonction rand() de la bibliothèque standard est protégée par un verrou global
+    /// qui sérialiserait les threads de la recherche.
+    uint64_t randState;
 
-    QuoridorPos pred[MAX_GRID_SIZE][MAX_GRID_SIZE];
-    memset(pred, -1, sizeof(pred));
+    /// @brief Nombre de noeuds visités depuis le début de la recherche.
+    int nodeCount;
 
-    unsigned int dist[MAX_GRID_SIZE][MAX_GRID_SIZE];
-    memset(dist, UINT_MAX, sizeof(dist));
+    /// @brief Indique si la recherche a été interrompue.
+    /// Dans ce cas, les scores renvoyés ne sont plus significatifs.
+    bool stopped;
 
-    QuoridorPos file[MAX_GRID_SIZE * MAX_GRID_SIZE];
-    memset(file, -1, sizeof(file));
-    int readCursor = 0;
-    int writeCursor = 0;
-    file[writeCursor].i = self->positions[playerID].i;
-    file[writeCursor++].j = self->positions[playerID].j;
+    /// @brief Groupe de threads de la recherche parallèle YBWC (NULL pour les autres recherches).
+    AIYBWC *ybwc;
 
-    int i = file[readCursor].i, j = file[readCursor].j;
-    dist[i][j] = 0;
+    /// @brief Indice du thread dans le groupe YBWC.
+    int threadIndex;
 
-    while (file[readCursor].i != -1 && readCursor < (gridSize * gridSize))
-    {
-        i = file[readCursor].i;
-        j = file[readCursor++].j;
+    /// @brief Point de séparation dont le thread explore actuellement un fils (NULL si aucun).
+    /// La recherche est interrompue si ce point ou l'un de ses ancêtres a produit une coupure.
+    AISplitPoint *splitPoint;
 
-        if (j == targetJ)
-            break;
+    /// @brief Statistiques propres au thread, additionnées à celles de la recherche à la fin du thread.
+    AIStats stats;
 
-        if (!QuoridorCore_hasWallAbove(self, i, j) && !explored[i - 1][j])
-        {
-            file[writeCursor].i = i - 1;
-            file[writeCursor++].j = j;
+    /// @brief Fonction appelée par le thread principal à la fin de chaque itération (peut être NULL).
+    AIIterationCallback onIteration;
 
-            pred[i - 1][j].i = i;
-            pred[i - 1][j].j = j;
+    /// @brief Pointeur transmis à onIteration.
+    void *userData;
 
-            explored[i - 1][j] = true;
-            dist[i - 1][j] = dist[i][j] + 1;
-        }
-        if (!QuoridorCore_hasWallBelow(self, i, j) && !explored[i + 1][j])
-        {
-            file[writeCursor].i = i + 1;
-            file[writeCursor++].j = j;
+    /// @brief Valeur de SDL_GetPerformanceCounter() au début de la recherche.
+    Uint64 startCounter;
 
-            pred[i + 1][j].i = i;
-            pred[i + 1][j].j = j;
+    /// @brief Poids de l'heuristique d'évaluation.
+    const AIEvalWeights *weights;
 
-            explored[i + 1][j] = true;
-            dist[i + 1][j] = dist[i][j] + 1;
-        }
-        if (!QuoridorCore_hasWallLeft(self, i, j) && !explored[i][j - 1])
-        {
-            file[writeCursor].i = i;
-            file[writeCursor++].j = j - 1;
+    /// @brief Profondeur et évaluation de la dernière itération terminée par le thread principal (0 : aucune).
+    int completedDepth;
+    float completedScore;
+} AISearch;
 
-            pred[i][j - 1].i = i;
-            pred[i][j - 1].j = j;
+/// @brief Renvoie un nombre pseudo-aléatoire compris entre 0 et 1 (xorshift64*).
+/// @param search Contexte de la recherche.
+static float AISearch_rand01(AISearch *search)
+{
+    uint64_t x = search->randState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    search->randState = x;
+    return (float)((x * 0x2545F4914F6CDD1DULL) >> 40) / (float)(1 << 24);
+}
 
-            explored[i][j - 1] = true;
-            dist[i][j - 1] = dist[i][j] + 1;
-        }
-        if (!QuoridorCore_hasWallRight(self, i, j) && !explored[i][j + 1])
-        {
-            file[writeCursor].i = i;
-            file[writeCursor++].j = j + 1;
+/// @brief Nombre de recherches lancées depuis le début du programme.
+/// Il sert de graine aux recherches (livre d'ouvertures et bruit de l'évaluation) :
+/// rand() ne peut pas être appelée depuis plusieurs threads.
+static SDL_AtomicInt s_searchCount;
 
-            pred[i][j + 1].i = i;
-            pred[i][j + 1].j = j;
+/// @brief Mélange une graine quelconque (splitmix64).
+static uint64_t AI_mixSeed(uint64_t seed)
+{
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
 
-            explored[i][j + 1] = true;
-            dist[i][j + 1] = dist[i][j] + 1;
-        }
-    }
+/// @brief Initialise le générateur pseudo-aléatoire d'une recherche.
+/// @param search Contexte de la recherche.
+/// @param seed Graine (quelconque).
+static void AISearch_seed(AISearch *search, uint64_t seed)
+{
+    // Le mélange garantit un état non nul et bien mélangé.
+    const uint64_t z = AI_mixSeed(seed);
+    search->randState = (z != 0) ? z : 1;
+}
 
-    *size = (int)dist[i][j] + 1;
-    QuoridorPos actual = {i, j};
+/// @brief Renvoie le temps écoulé depuis un instant donné, en millisecondes.
+/// @param start Valeur de SDL_GetPerformanceCounter() à l'instant de départ.
+static double AISearch_getElapsedMS(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+/// @brief Reconstitue la variante principale en suivant les meilleurs coups de la table de transposition.
+/// Les coups illégaux (collision de clés) et les parties terminées arrêtent la variante.
+/// @param root Position de la racine (non modifiée).
+/// @param turn Meilleur coup de la racine.
+/// @param table Table de transposition (peut être NULL).
+/// @param rootKey Clé du joueur à la racine (voir AISearch.rootKey).
+/// @param pv Tableau dans lequel sont écrits les tours de la variante.
+/// @param maxLength Nombre maximal de tours.
+/// @return Le nombre de tours de la variante.
+static int QuoridorCore_getPrincipalVariation(
+    const QuoridorCore *root, QuoridorTurn turn, QuoridorTT *table, uint64_t rootKey, QuoridorTurn *pv, int maxLength)
+{
+    QuoridorCore board = *root;
+    int length = 0;
 
-    for (int k = 0; k < *size; k++)
+    while (length < maxLength && board.state == QUORIDOR_STATE_IN_PROGRESS
+        && QuoridorCore_canPlayTurn(&board, turn))
     {
-        path[k].i = actual.i;
-        path[k].j = actual.j;
+        pv[length++] = turn;
+        QuoridorCore_playTurn(&board, turn);
 
-        actual = pred[actual.i][actual.j];
+        QuoridorTTData ttData;
+        if (table == NULL || !QuoridorTT_probe(table, board.hashKey ^ rootKey, &ttData))
+            break;
+        turn = ttData.turn;
     }
+    return length;
 }
-#endif
+
+/// @brief Mémorise le résultat d'une itération terminée et le transmet à la fonction de l'appelant.
+/// @param search Contexte de la recherche.
+/// @param root Position de la racine.
+/// @param depth Profondeur de l'itération.
+/// @param value Évaluation de la racine.
+/// @param turn Meilleur coup trouvé.
+static void AISearch_reportIteration(AISearch *search, const QuoridorCore *root, int depth, float value, QuoridorTurn turn)
+{
+    search->completedDepth = depth;
+    search->completedScore = value;
+
+    if (search->onIteration == NULL)
+        return;
+
+    AIIterationInfo info = { 0 };
+    info.depth = depth;
+    info.score = value;
+    info.nodeCount = search->nodeCount;
+    info.elapsedMS = AISearch_getElapsedMS(search->startCounter);
+    info.pvLength = QuoridorCore_getPrincipalVariation(
+        root, turn, search->table, search->rootKey, info.pv, Int_min(depth, AI_MAX_PV_LENGTH));
+
+    search->onIteration(search->userData, &info);
+}
+
+const AIEvalWeights AIEvalWeights_default = {
+    .pathDifference = 3.0f,
+    .pathLength = 2.0f,
+    .threat = 10.0f,
+    .wallCount = 1.0f,
+    .center = 1.5f,
+    .earlyWall = 10.0f,
+};
 
 /// @brief Calcule une heuristique d'évaluation de l'état du jeu pour un joueur donné.
 /// Cette fonction est utilisée dans l'algorithme Min-Max pour estimer la qualité d'une position.
@@ -271,103 +308,118 @@ void QuoridorCore_getShortestPath(QuoridorCore *self, int playerID, QuoridorPos
 /// Une valeur positive indique un avantage pour ce joueur, une valeur négative indique un avantage pour l'adversaire.
 /// @param self Instance du jeu Quoridor.
 /// @param playerID Indice du joueur à évaluer (0 ou 1).
+/// @param weights Poids des termes de l'évaluation.
+/// Cette version ne contient pas de bruit aléatoire : il est ajouté par l'appelant.
 /// @return Une estimation numérique de l'avantage du joueur playerID.
-float QuoridorCore_computeScore(QuoridorCore *self, int playerID, QuoridorTurn turn)
+static float QuoridorCore_evaluate(
+    QuoridorCore *self, int playerID, QuoridorTurn turn, const AIEvalWeights *weights)
 {
     int playerA = playerID;
     int playerB = playerID ^ 1;
 
-    QuoridorPath my_path;
-    QuoridorPath other_path;
-
-    QuoridorCore_getShortestPath(self, playerA, my_path.tiles, &(my_path.size));
-    QuoridorCore_getShortestPath(self, playerB, other_path.tiles, &(other_path.size));
+    // Tailles des plus courts chemins (nombre de cases, soit la distance + 1),
+    // lues directement dans les champs de distances du plateau.
+    const int myPathSize = QuoridorCore_getPathLength(self, playerA) + 1;
+    const int otherPathSize = QuoridorCore_getPathLength(self, playerB) + 1;
 
     int mySpawn = (playerA == 0) ? 0 : self->gridSize - 1;
     int otherSpawn = (playerB == 0) ? 0 : self->gridSize - 1;
 
     float score = 0;
     // Différence de distance à parcourir
-    score += (other_path.size - my_path.size) * 3;
-    score += (17 - my_path.size) * 2;
+    score += (otherPathSize - myPathSize) * weights->pathDifference;
+    score += (17 - myPathSize) * weights->pathLength;
 
     // Chemin de l'adversaire simple et court
-    if (other_path.size <= 4 && abs(self->positions[playerB].j - mySpawn) <= 3)
+    if (otherPathSize <= 4 && abs(self->positions[playerB].j - mySpawn) <= 3)
     {
-        score -= 10;
+        score -= weights->threat;
     }
 
     // Nombre de murs restants
-    score += self->wallCounts[playerA] * 1;
+    score += self->wallCounts[playerA] * weights->wallCount;
 
     // Distance du centre
     int center = self->gridSize / 2;
 
     int center_score = (abs(self->positions[playerA].i - center) + abs(self->positions[playerA].j - center));
-    if (my_path.size >= center)
-        score += center_score * 1.5;
+    if (myPathSize >= center)
+        score += center_score * weights->center;
 
     center_score = (abs(self->positions[playerB].i - center) + abs(self->positions[playerB].j - center));
-    if (other_path.size >= center)
-        score -= center_score * 1.5;
+    if (otherPathSize >= center)
+        score -= center_score * weights->center;
 
     // Inciter à jouer des murs un peu plus tot
     if (turn.action != QUORIDOR_MOVE_TO && abs(self->positions[playerB].j - otherSpawn) < center)
-        score += 10;
+        score += weights->earlyWall;
 
     // Condition victoire / défaite
-    if (my_path.size - 1 == 1)
+    if (myPathSize - 1 == 1)
         score += 9000;
-    if (other_path.size - 1 == 1)
+    if (otherPathSize - 1 == 1)
         score -= 9000;
 
-    return score + (Float_rand01() / 2.0f);
+    return score;
 }
 
-static float QuoridorCore_computeWall(QuoridorCore self, int playerID, QuoridorPath my_path, QuoridorPath other_path, QuoridorTurn turn)
+float QuoridorCore_computeScore(QuoridorCore *self, int playerID, QuoridorTurn turn)
+{
+    return QuoridorCore_evaluate(self, playerID, turn, &AIEvalWeights_default) + (Float_rand01() / 2.0f);
+}
+
+float QuoridorCore_computeStaticScore(QuoridorCore *self, int playerID, QuoridorTurn turn)
+{
+    return QuoridorCore_evaluate(self, playerID, turn, &AIEvalWeights_default);
+}
+
+static float QuoridorCore_computeWall(
+    QuoridorCore *self, int playerID, QuoridorPath *my_path, QuoridorPath *other_path,
+    QuoridorTurn turn, AISearch *search)
 {
     // Différence des chemins
     float score = 0;
-    score += (other_path.size - my_path.size) * 3;
+    score += (other_path->size - my_path->size) * 3;
 
     // Proximité du chemin adverse
-    for (int i = 0; i < other_path.size; i++)
+    for (int i = 0; i < other_path->size; i++)
     {
-        int distance = abs(turn.i - other_path.tiles[i].i) + abs(turn.j - other_path.tiles[i].j);
+        int distance = abs(turn.i - other_path->tiles[i].i) + abs(turn.j - other_path->tiles[i].j);
         score += (2 - distance) * 2;
     }
-    for (int i = 0; i < my_path.size; i++)
+    for (int i = 0; i < my_path->size; i++)
     {
-        int distance = abs(turn.i - other_path.tiles[i].i) + abs(turn.j - other_path.tiles[i].j);
+        int distance = abs(turn.i - other_path->tiles[i].i) + abs(turn.j - other_path->tiles[i].j);
         if (turn.action == QUORIDOR_PLAY_HORIZONTAL_WALL)
             score += (3 - distance) * 1.5;
     }
 
     // Proximité à l'adversaire
-    int distance = abs(turn.i - self.positions[playerID ^ 1].i) + abs(turn.j - self.positions[playerID ^ 1].j);
+    int distance = abs(turn.i - self->positions[playerID ^ 1].i) + abs(turn.j - self->positions[playerID ^ 1].j);
     if (distance <= 3)
         score += (3 - distance) * 1;
 
     // Chemin dans notre dos
-    if ((playerID == 0 && turn.j < self.positions[playerID].j) || (playerID == 1 && turn.j >= self.positions[playerID].j))
+    if ((playerID == 0 && turn.j < self->positions[playerID].j) || (playerID == 1 && turn.j >= self->positions[playerID].j))
         score += 10;
 
     // Continuité des chemins
     if (turn.action == QUORIDOR_PLAY_VERTICAL_WALL)
     {
-        if (self.hWalls[turn.i][turn.j - 1] != WALL_STATE_NONE || self.hWalls[turn.i][turn.j + 1] != WALL_STATE_NONE)
+        if (QuoridorCore_getWallState(self, WALL_TYPE_HORIZONTAL, turn.i, turn.j - 1) != WALL_STATE_NONE ||
+            QuoridorCore_getWallState(self, WALL_TYPE_HORIZONTAL, turn.i, turn.j + 1) != WALL_STATE_NONE)
             score -= 25;
 
         for (int i = turn.i - 1; i >= 0; i--)
         {
-            if (self.vWalls[i][turn.j] != WALL_STATE_NONE)
+            if (QuoridorCore_getWallState(self, WALL_TYPE_VERTICAL, i, turn.j) != WALL_STATE_NONE)
                 score += 1;
             else
                 break;
         }
-        for (int i = turn.i + 2; i < self.gridSize; i++)
+        for (int i = turn.i + 2; i < self->gridSize; i++)
         {
-            if (self.vWalls[i][turn.j] != WALL_STATE_NONE)
+            if (QuoridorCore_getWallState(self, WALL_TYPE_VERTICAL, i, turn.j) != WALL_STATE_NONE)
                 score += 1;
             else
                 break;
@@ -375,26 +427,27 @@ static float QuoridorCore_computeWall(QuoridorCore self, int playerID, QuoridorP
     }
     else
     {
-        if (self.vWalls[turn.i - 1][turn.j] != WALL_STATE_NONE || self.vWalls[turn.i + 1][turn.j] != WALL_STATE_NONE)
+        if (QuoridorCore_getWallState(self, WALL_TYPE_VERTICAL, turn.i - 1, turn.j) != WALL_STATE_NONE ||
+            QuoridorCore_getWallState(self, WALL_TYPE_VERTICAL, turn.i + 1, turn.j) != WALL_STATE_NONE)
             score -= 25;
 
         for (int j = turn.j - 1; j >= 0; j--)
         {
-            if (self.hWalls[turn.i][j] != WALL_STATE_NONE)
+            if (QuoridorCore_getWallState(self, WALL_TYPE_HORIZONTAL, turn.i, j) != WALL_STATE_NONE)
                 score += 1;
             else
                 break;
         }
-        for (int j = turn.j + 2; j < self.gridSize; j++)
+        for (int j = turn.j + 2; j < self->gridSize; j++)
         {
-            if (self.hWalls[turn.i][j] != WALL_STATE_NONE)
+            if (QuoridorCore_getWallState(self, WALL_TYPE_HORIZONTAL, turn.i, j) != WALL_STATE_NONE)
                 score += 1;
             else
                 break;
         }
     }
 
-    return score + Float_rand01();
+    return score + AISearch_rand01(search);
 }
 
 int QuoridorCore_compareWall(const void *first, const void *second)
@@ -415,234 +468,1220 @@ int QuoridorCore_compareWall(const void *first, const void *second)
         return 0;
 }
 
-#if DEBUG
-static int movesAtDepth[10] = {0};
-static int nodeVisited = 0;
-static float totalValues = 0;
-#endif
+/// @brief Indique si deux tours sont identiques.
+static bool QuoridorTurn_equals(QuoridorTurn a, QuoridorTurn b)
+{
+    return a.action == b.action && a.i == b.i && a.j == b.j;
+}
 
-/// @brief Applique l'algorithme Min-Max (avec élagage alpha-bêta) pour déterminer le coup joué par l'IA.
-/// Cette fonction explore récursivement une partie de l'arbre des coups possibles jusqu'à une profondeur maximale donnée.
+/// @brief Nombre maximal de fils explorés depuis un noeud.
+#define AI_MAX_CHILDREN (MAX_MOVES_AVAILABLE * 2 + 8)
+
+/// @brief Génère les fils explorés depuis la position courante, dans l'ordre d'exploration.
 /// @param self Instance du jeu Quoridor.
 /// @param playerID Identifiant du joueur pour lequel on cherche le meilleur coup.
-/// @param currDepth Profondeur actuelle dans l'arbre de recherche.
-/// @param maxDepth Profondeur maximale à atteindre dans l'arbre.
-/// @param alpha Meilleure valeur actuellement garantie pour le joueur maximisant.
-/// @param beta Meilleure valeur actuellement garantie pour le joueur minimisant.
-/// @param turn Pointeur vers une variable où sera enregistré le meilleur coup trouvé (à la racine).
-/// @return L'évaluation numérique de la position courante, selon la fonction heuristique.
-static float QuoridorCore_minMax(
-    QuoridorCore *self, int playerID, int currDepth, int maxDepth,
-    float alpha, float beta, QuoridorTurn *turn, void *AIdata)
+/// @param ttTurn Meilleur coup connu de la position (exploré en premier s'il est légal), ou un tour indéfini.
+/// @param search Contexte de la recherche.
+/// @param children Tableau d'au moins AI_MAX_CHILDREN tours dans lequel sont écrits les fils.
+/// @return Le nombre de fils.
+static int QuoridorCore_generateChildren(
+    QuoridorCore *self, int playerID, QuoridorTurn ttTurn, AISearch *search, QuoridorTurn *children)
 {
-#if DEBUG
-    nodeVisited++;
-#endif
-    switch (self->state)
-    {
-    case QUORIDOR_STATE_P0_WON:
-        return (playerID == 1) ? -10000 + currDepth * 2 : 10000 - currDepth * 2;
-    case QUORIDOR_STATE_P1_WON:
-        return (playerID == 1) ? 10000 - currDepth * 2 : -10000 + currDepth * 2;
-    default:
-        break;
-    }
-
-    if (currDepth >= maxDepth)
-        return QuoridorCore_computeScore(self, playerID, *turn);
-
     const int gridSize = self->gridSize;
 
-    const int currI = self->positions[self->playerID].i;
-    const int currJ = self->positions[self->playerID].j;
-    const int otherI = self->positions[self->playerID ^ 1].i;
-    const int otherJ = self->positions[self->playerID ^ 1].j;
-
-    QuoridorTurn childTurn = {0};
-
-    // TODO
-
-    // Astuce :
-    // vous devez effectuer toutes vos actions sur une copie du plateau courant.
-    // Comme la structure QuoridorCore ne contient aucune allocation interne,
-    // la copie s'éffectue simplement avec :
-    // QuoridorCore gameCopy = *self;
-
-    bool maximizing = (!(currDepth & 1)) ? true : false;
-    float value = (maximizing) ? -INFINITY : INFINITY;
-    float currValue;
-
-    QuoridorCore gameCopy = *self;
-    QuoridorTurn currTurn;
-
-    QuoridorPath my_path;
-    QuoridorPath other_path;
-    QuoridorPath currPath;
+    QuoridorPath my_path = { 0 };
+    QuoridorPath other_path = { 0 };
 
     QuoridorCore_getShortestPath(self, playerID, my_path.tiles, &(my_path.size));
     QuoridorCore_getShortestPath(self, playerID ^ 1, other_path.tiles, &(other_path.size));
 
-    currPath = (playerID == self->playerID) ? my_path : other_path;
-
-    TurnToSort list[MAX_NUM_WALL] = {0};
+    TurnToSort list[MAX_NUM_WALL] = { 0 };
     QuoridorPos moves[10];
     memset(moves, -1, sizeof(moves));
 
     size_t pos = 0;
-    size_t movesPos = 1;
+    size_t movesPos = 0;
+
+    QuoridorMask hLegal, vLegal;
+    QuoridorCore_generateLegalWalls(self, &hLegal, &vLegal);
 
     for (int i = 0; i < gridSize; i++)
     {
         for (int j = 0; j < gridSize; j++)
         {
-            if (self->isValid[i][j])
+            if (QuoridorCore_canMoveTo(self, i, j))
             {
-                currTurn.i = i;
-                currTurn.j = j;
-
-                if (currTurn.i == currPath.tiles[currPath.size - 2].i && currTurn.j == currPath.tiles[currPath.size - 2].j)
-                {
-                    moves[0].i = i;
-                    moves[0].j = j;
-                }
-
-                else
+                // Les déplacements sont triés par distance à l'arrivée (lue dans le champ de distances) :
+                // un pas sur un plus court chemin est exploré avant un pas de côté ou en arrière.
+                const int dist = QuoridorCore_getDistance(self, self->playerID, i, j);
+                size_t k = movesPos++;
+                while (k > 0 && QuoridorCore_getDistance(self, self->playerID, moves[k - 1].i, moves[k - 1].j) > dist)
                 {
-                    moves[movesPos].i = i;
-                    moves[movesPos++].j = j;
+                    moves[k] = moves[k - 1];
+                    k--;
                 }
+                moves[k].i = i;
+                moves[k].j = j;
             }
 
-            if (QuoridorCore_canPlayWall(&gameCopy, WALL_TYPE_VERTICAL, i, j))
+            if (QuoridorMask_test(vLegal, i * MAX_GRID_SIZE + j))
             {
                 list[pos].turn.action = QUORIDOR_PLAY_VERTICAL_WALL;
                 list[pos].turn.i = i;
                 list[pos].turn.j = j;
-                list[pos].value = QuoridorCore_computeWall(gameCopy, playerID, my_path, other_path, list[pos].turn);
+                list[pos].value = QuoridorCore_computeWall(self, playerID, &my_path, &other_path, list[pos].turn, search);
                 pos++;
             }
 
-            if (QuoridorCore_canPlayWall(&gameCopy, WALL_TYPE_HORIZONTAL, i, j))
+            if (QuoridorMask_test(hLegal, i * MAX_GRID_SIZE + j))
             {
                 list[pos].turn.action = QUORIDOR_PLAY_HORIZONTAL_WALL;
                 list[pos].turn.i = i;
                 list[pos].turn.j = j;
-                list[pos].value = QuoridorCore_computeWall(gameCopy, playerID, my_path, other_path, list[pos].turn);
+                list[pos].value = QuoridorCore_computeWall(self, playerID, &my_path, &other_path, list[pos].turn, search);
                 pos++;
             }
         }
     }
 
-    // Déplacements
+    if (pos > 0)
+        qsort(list, pos, sizeof(TurnToSort), QuoridorCore_compareWall);
+
+    // Ordre d'exploration :
+    // le meilleur coup de la table de transposition (s'il est légal), les déplacements
+    // (le pas sur le plus court chemin en premier), puis les meilleurs murs selon l'heuristique.
+    int childCount = 0;
+    bool ttMoveFound = false;
+
+    if (ttTurn.action != QUORIDOR_ACTION_UNDEFINED)
+    {
+        for (int i = 0; i < movesPos && !ttMoveFound; i++)
+        {
+            ttMoveFound = ttTurn.action == QUORIDOR_MOVE_TO
+                && moves[i].i == ttTurn.i && moves[i].j == ttTurn.j;
+        }
+        for (int i = 0; i < pos && !ttMoveFound; i++)
+        {
+            ttMoveFound = QuoridorTurn_equals(list[i].turn, ttTurn);
+        }
+        if (ttMoveFound)
+            children[childCount++] = ttTurn;
+    }
+
     for (int i = 0; i < movesPos; i++)
     {
         if (moves[i].i == -1)
             continue;
 
+        QuoridorTurn currTurn;
         currTurn.action = QUORIDOR_MOVE_TO;
         currTurn.i = moves[i].i;
         currTurn.j = moves[i].j;
 
-        QuoridorCore_playTurn(&gameCopy, currTurn);
-        currValue = QuoridorCore_minMax(&gameCopy, playerID, currDepth + 1, maxDepth, alpha, beta, &childTurn, AIdata);
-        gameCopy = *self;
+        if (!ttMoveFound || !QuoridorTurn_equals(currTurn, ttTurn))
+            children[childCount++] = currTurn;
+    }
 
-#if DEBUG
-        totalValues += currValue;
-        movesAtDepth[currDepth]++;
-#endif
+    int limit = (pos < 7) ? (int)pos : 7;
+    for (int i = 0; i < limit; i++)
+    {
+        if (!ttMoveFound || !QuoridorTurn_equals(list[i].turn, ttTurn))
+            children[childCount++] = list[i].turn;
+    }
+
+
+    // Les threads auxiliaires commencent par des fils différents (le meilleur coup connu reste en tête).
+    const int first = (ttMoveFound) ? 1 : 0;
+    if (search->helperID > 0 && childCount - first > 1)
+    {
+        QuoridorTurn rotated[AI_MAX_CHILDREN];
+        const int count = childCount - first;
+        const int shift = search->helperID % count;
+        for (int i = 0; i < count; i++)
+            rotated[i] = children[first + (i + shift) % count];
+        memcpy(children + first, rotated, count * sizeof(QuoridorTurn));
+    }
+
+    return childCount;
+}
+
+/// @brief Indique si l'échéance de la recherche est dépassée ou si son drapeau d'arrêt est levé.
+static bool AISearch_isInterrupted(AISearch *search)
+{
+    if (search->deadline && SDL_GetTicks() >= search->deadline)
+        return true;
+    return search->stopFlag && SDL_GetAtomicInt(search->stopFlag);
+}
+
+/// @brief Profondeur restante minimale d'un noeud pour qu'il soit partagé entre plusieurs threads.
+#define AI_YBWC_MIN_SPLIT_DEPTH 2
+
+/// @brief Noeud dont les fils sont explorés par plusieurs threads (Young Brothers Wait).
+/// Le premier fils est exploré seul par le thread propriétaire ;
+/// les suivants sont ensuite pris par les threads inoccupés.
+/// Les champs modifiables sont protégés par le mutex du groupe de threads.
+struct AISplitPoint
+{
+    /// @brief Point de séparation dont le propriétaire explore un fils (NULL si aucun).
+    AISplitPoint *parent;
+
+    /// @brief Copie de la position du noeud, utilisée par les autres threads.
+    QuoridorCore position;
+
+    int playerID;
+    int currDepth;
+    int maxDepth;
+    bool maximizing;
+
+    /// @brief Échéance de la recherche du propriétaire.
+    Uint64 deadline;
+
+    /// @brief Fils du noeud, dans l'ordre d'exploration.
+    QuoridorTurn children[AI_MAX_CHILDREN];
+    int childCount;
+
+    /// @brief Indice du prochain fils à explorer.
+    int nextChild;
+
+    /// @brief Fenêtre courante, resserrée à chaque fils exploré.
+    float alpha;
+    float beta;
+
+    /// @brief Meilleure valeur et meilleur coup trouvés.
+    float value;
+    QuoridorTurn bestTurn;
+
+    /// @brief Levé lorsqu'un fils produit une coupure : les autres fils sont abandonnés.
+    SDL_AtomicInt cutoff;
+
+    /// @brief Nombre de threads (autres que le propriétaire) explorant un fils du noeud.
+    int helperCount;
+
+    /// @brief Indique que le propriétaire n'accepte plus de nouveaux threads.
+    bool closed;
+};
+
+/// @brief Groupe de threads d'une recherche parallèle YBWC.
+/// Chaque thread empile ses points de séparation dans sa propre file ;
+/// les threads inoccupés rejoignent le point le moins profond encore ouvert d'une autre file.
+/// Un propriétaire qui attend la fin de ses auxiliaires les aide à son tour (voir QuoridorCore_split()).
+struct AIYBWC
+{
+    /// @brief Mutex protégeant les files et les points de séparation.
+    SDL_Mutex *mutex;
+
+    /// @brief Condition signalée à chaque nouveau point de séparation et à chaque départ d'un thread.
+    SDL_Condition *condition;
+
+    /// @brief Files des points de séparation de chaque thread (du moins profond au plus profond).
+    AISplitPoint *deques[AI_MAX_THREADS][AI_MAX_DEPTH + 1];
+    int dequeSizes[AI_MAX_THREADS];
+
+    /// @brief Nombre de threads du groupe.
+    int threadCount;
+
+    /// @brief Nombre de threads en attente de travail.
+    SDL_AtomicInt idleCount;
+
+    /// @brief Indique que les threads auxiliaires doivent se terminer.
+    bool quit;
+};
+
+/// @brief Indique si un point de séparation ou l'un de ses ancêtres a produit une coupure.
+static bool AISplitPoint_isCutOff(AISplitPoint *self)
+{
+    for (; self != NULL; self = self->parent)
+    {
+        if (SDL_GetAtomicInt(&self->cutoff))
+            return true;
+    }
+    return false;
+}
+
+static float QuoridorCore_minMax(
+    QuoridorCore *self, int playerID, int currDepth, int maxDepth,
+    float alpha, float beta, QuoridorTurn *turn, AISearch *search);
+
+/// @brief Explore les fils restants d'un point de séparation.
+/// Appelée par le propriétaire et par les threads qui le rejoignent, sans le mutex du groupe.
+/// @param self Point de séparation.
+/// @param board Plateau du thread, dans la position du noeud.
+/// @param search Contexte de recherche du thread.
+static void AISplitPoint_work(AISplitPoint *self, QuoridorCore *board, AISearch *search)
+{
+    AIYBWC *ybwc = search->ybwc;
+    AISplitPoint *prevSplitPoint = search->splitPoint;
+
+    SDL_LockMutex(ybwc->mutex);
+    while (!SDL_GetAtomicInt(&self->cutoff) && self->nextChild < self->childCount)
+    {
+        const int i = self->nextChild++;
+        const float alpha = self->alpha;
+        const float beta = self->beta;
+        SDL_UnlockMutex(ybwc->mutex);
+
+        const QuoridorTurn currTurn = self->children[i];
+        QuoridorTurn childTurn = currTurn;
+        QuoridorUndo undo;
+
+        QuoridorCore_makeTurn(board, currTurn, &undo);
+        search->splitPoint = self;
+        const float value = QuoridorCore_minMax(
+            board, self->playerID, self->currDepth + 1, self->maxDepth, alpha, beta, &childTurn, search);
+        search->splitPoint = prevSplitPoint;
+        QuoridorCore_unmakeTurn(board, currTurn, &undo);
+
+        SDL_LockMutex(ybwc->mutex);
+        if (search->stopped)
+        {
+            // Une coupure de ce noeud seul n'interrompt pas la recherche du thread.
+            if (!AISearch_isInterrupted(search) && !AISplitPoint_isCutOff(self->parent))
+                search->stopped = false;
+            break;
+        }
+
+        if ((self->maximizing && value > self->value) || (!self->maximizing && value < self->value))
+        {
+            self->value = value;
+            self->bestTurn = currTurn;
+        }
+
+        if ((self->maximizing && self->value >= self->beta) || (!self->maximizing && self->value <= self->alpha))
+        {
+            SDL_SetAtomicInt(&self->cutoff, 1);
+            break;
+        }
+
+        if (self->maximizing && self->alpha < self->value) self->alpha = self->value;
+        if (!self->maximizing && self->beta > self->value) self->beta = self->value;
+    }
+    SDL_UnlockMutex(ybwc->mutex);
+}
+
+/// @brief Indique si un point de séparation descend d'un autre (ou est cet autre).
+static bool AISplitPoint_isDescendant(const AISplitPoint *self, const AISplitPoint *ancestor)
+{
+    for (; self != NULL; self = self->parent)
+    {
+        if (self == ancestor)
+            return true;
+    }
+    return false;
+}
+
+/// @brief Renvoie le point de séparation ouvert le moins profond. Le mutex doit être verrouillé.
+/// @param self Groupe de threads.
+/// @param threadIndex Indice du thread qui cherche du travail (ses propres points sont ignorés).
+/// @param ancestor Si non NULL, seuls les points qui descendent de celui-ci sont retenus.
+static AISplitPoint *AIYBWC_findWork(AIYBWC *self, int threadIndex, const AISplitPoint *ancestor)
+{
+    AISplitPoint *best = NULL;
+    for (int t = 0; t < self->threadCount; t++)
+    {
+        if (t == threadIndex)
+            continue;
+
+        // Les points les plus proches de la racine offrent les plus gros sous-arbres.
+        for (int k = 0; k < self->dequeSizes[t]; k++)
+        {
+            AISplitPoint *sp = self->deques[t][k];
+            if (sp->closed || SDL_GetAtomicInt(&sp->cutoff) || sp->nextChild >= sp->childCount)
+                continue;
+            if (ancestor && !AISplitPoint_isDescendant(sp, ancestor))
+                continue;
+
+            if (best == NULL || sp->currDepth < best->currDepth)
+                best = sp;
+            break;
+        }
+    }
+    return best;
+}
+
+static int AIYBWC_run(void *data)
+{
+    AISearch search = *(AISearch *)data;
+    AIYBWC *ybwc = search.ybwc;
+
+    SDL_LockMutex(ybwc->mutex);
+    while (!ybwc->quit)
+    {
+        AISplitPoint *sp = AIYBWC_findWork(ybwc, search.threadIndex, NULL);
+        if (sp == NULL)
+        {
+            SDL_AddAtomicInt(&ybwc->idleCount, 1);
+            SDL_WaitCondition(ybwc->condition, ybwc->mutex);
+            SDL_AddAtomicInt(&ybwc->idleCount, -1);
+            continue;
+        }
+
+        sp->helperCount++;
+        SDL_UnlockMutex(ybwc->mutex);
+
+        QuoridorCore board = sp->position;
+        search.deadline = sp->deadline;
+        search.stopped = false;
+        search.splitPoint = NULL;
+        AISplitPoint_work(sp, &board, &search);
+
+        SDL_LockMutex(ybwc->mutex);
+        sp->helperCount--;
+        SDL_BroadcastCondition(ybwc->condition);
+    }
+    SDL_UnlockMutex(ybwc->mutex);
+
+    // Les statistiques sont lues par le thread principal après la fin de ce thread.
+    ((AISearch *)data)->stats = search.stats;
+    return 0;
+}
+
+/// @brief Indique si les fils restants d'un noeud doivent être partagés avec d'autres threads.
+static bool AIYBWC_canSplit(AISearch *search, int remainingDepth, int remainingChildren)
+{
+    return search->ybwc != NULL
+        && remainingDepth >= AI_YBWC_MIN_SPLIT_DEPTH
+        && remainingChildren > 1
+        && SDL_GetAtomicInt(&search->ybwc->idleCount) > 0;
+}
+
+/// @brief Partage les fils restants d'un noeud avec les threads inoccupés et attend leur exploration.
+/// En attendant, le propriétaire aide ses auxiliaires : il rejoint les points de séparation qu'ils
+/// ont créés sous ce noeud, ce qui garantit qu'il est libre dès que le dernier d'entre eux a fini.
+/// Les bornes, la valeur et le meilleur coup du noeud sont mis à jour.
+static void QuoridorCore_split(
+    QuoridorCore *self, int playerID, int currDepth, int maxDepth,
+    const QuoridorTurn *children, int firstChild, int childCount,
+    float *alpha, float *beta, float *value, QuoridorTurn *bestTurn, AISearch *search)
+{
+    AIYBWC *ybwc = search->ybwc;
+
+    AISplitPoint sp = { 0 };
+    sp.parent = search->splitPoint;
+    sp.position = *self;
+    sp.playerID = playerID;
+    sp.currDepth = currDepth;
+    sp.maxDepth = maxDepth;
+    sp.maximizing = !(currDepth & 1);
+    sp.deadline = search->deadline;
+    memcpy(sp.children, children, childCount * sizeof(QuoridorTurn));
+    sp.childCount = childCount;
+    sp.nextChild = firstChild;
+    sp.alpha = *alpha;
+    sp.beta = *beta;
+    sp.value = *value;
+    sp.bestTurn = *bestTurn;
+    SDL_SetAtomicInt(&sp.cutoff, 0);
+
+    SDL_LockMutex(ybwc->mutex);
+    const int threadIndex = search->threadIndex;
+    ybwc->deques[threadIndex][ybwc->dequeSizes[threadIndex]++] = &sp;
+    SDL_BroadcastCondition(ybwc->condition);
+    SDL_UnlockMutex(ybwc->mutex);
+
+    AISplitPoint_work(&sp, self, search);
+
+    SDL_LockMutex(ybwc->mutex);
+    sp.closed = true;
+    while (sp.helperCount > 0)
+    {
+        AISplitPoint *work = AIYBWC_findWork(ybwc, threadIndex, &sp);
+        if (work == NULL)
+        {
+            // Le propriétaire compte comme inoccupé : ses auxiliaires peuvent partager leurs noeuds avec lui.
+            SDL_AddAtomicInt(&ybwc->idleCount, 1);
+            SDL_WaitCondition(ybwc->condition, ybwc->mutex);
+            SDL_AddAtomicInt(&ybwc->idleCount, -1);
+            continue;
+        }
+
+        work->helperCount++;
+        SDL_UnlockMutex(ybwc->mutex);
+
+        QuoridorCore board = work->position;
+        AISplitPoint_work(work, &board, search);
+
+        // Une coupure sous ce noeud n'interrompt pas sa recherche ; l'interruption est vérifiée plus bas.
+        search->stopped = false;
+
+        SDL_LockMutex(ybwc->mutex);
+        work->helperCount--;
+        SDL_BroadcastCondition(ybwc->condition);
+    }
+    ybwc->dequeSizes[threadIndex]--;
+
+    *alpha = sp.alpha;
+    *beta = sp.beta;
+    *value = sp.value;
+    *bestTurn = sp.bestTurn;
+    SDL_UnlockMutex(ybwc->mutex);
+
+    // Un autre thread a pu abandonner un fils parce que la recherche est interrompue
+    // ou qu'un ancêtre a produit une coupure : le résultat du noeud est alors incomplet.
+    if (AISearch_isInterrupted(search) || AISplitPoint_isCutOff(sp.parent))
+        search->stopped = true;
+}
+
+/// @brief Applique l'algorithme Min-Max (avec élagage alpha-bêta) pour déterminer le coup joué par l'IA.
+/// Cette fonction explore récursivement une partie de l'arbre des coups possibles jusqu'à une profondeur maximale donnée.
+/// Les positions déjà analysées sont lues et enregistrées dans la table de transposition de l'IA (si elle existe).
+/// La recherche s'interrompt dès que l'échéance du contexte est dépassée ou que son drapeau d'arrêt est levé.
+/// @param self Instance du jeu Quoridor.
+/// @param playerID Identifiant du joueur pour lequel on cherche le meilleur coup.
+/// @param currDepth Profondeur actuelle dans l'arbre de recherche.
+/// @param maxDepth Profondeur maximale à atteindre dans l'arbre.
+/// @param alpha Meilleure valeur actuellement garantie pour le joueur maximisant.
+/// @param beta Meilleure valeur actuellement garantie pour le joueur minimisant.
+/// @param turn Pointeur vers le dernier tour joué, dans lequel sera enregistré le meilleur coup trouvé.
+/// @param search Contexte de la recherche.
+/// @return L'évaluation numérique de la position courante, selon la fonction heuristique.
+static float QuoridorCore_minMax(
+    QuoridorCore *self, int playerID, int currDepth, int maxDepth,
+    float alpha, float beta, QuoridorTurn *turn, AISearch *search)
+{
+    search->nodeCount++;
+    if ((search->nodeCount % AI_CLOCK_CHECK_INTERVAL) == 0)
+    {
+        if (AISearch_isInterrupted(search) || AISplitPoint_isCutOff(search->splitPoint))
+            search->stopped = true;
+    }
+    if (search->stopped)
+        return 0;
+
+    AIStats_countNode(&search->stats, currDepth);
+
+    switch (self->state)
+    {
+    case QUORIDOR_STATE_P0_WON:
+        return (playerID == 1) ? -10000 + currDepth * 2 : 10000 - currDepth * 2;
+    case QUORIDOR_STATE_P1_WON:
+        return (playerID == 1) ? 10000 - currDepth * 2 : -10000 + currDepth * 2;
+    default:
+        break;
+    }
+
+    if (currDepth >= maxDepth)
+        return QuoridorCore_evaluate(self, playerID, *turn, search->weights) + (AISearch_rand01(search) / 2.0f);
+
+    const int remainingDepth = maxDepth - currDepth;
+    QuoridorTT *table = search->table;
+
+    // Toutes les actions sont effectuées directement sur le plateau courant :
+    // chaque coup est joué avec QuoridorCore_makeTurn() puis annulé avec QuoridorCore_unmakeTurn()
+    // dès que le sous-arbre correspondant a été évalué.
+
+    bool maximizing = (!(currDepth & 1)) ? true : false;
+    float value = (maximizing) ? -INFINITY : INFINITY;
+    float currValue;
+
+    const float alphaOrig = alpha;
+    const float betaOrig = beta;
+
+    // Table de transposition
+    // Les scores y sont stockés du point de vue du joueur qui doit jouer
+    // et les scores de fin de partie relativement à la position courante.
+    // Ils dépendent de l'évaluation du joueur à la racine : la clé inclut ce joueur (rootKey).
+    QuoridorTTData ttData = { 0 };
+    bool ttHit = false;
+    if (table != NULL)
+    {
+        ttHit = QuoridorTT_probe(table, self->hashKey ^ search->rootKey, &ttData);
+        AIStats_countProbe(&search->stats, ttHit);
+    }
+    if (ttHit && currDepth > 0 && ttData.depth >= remainingDepth)
+    {
+        float ttValue = (maximizing) ? ttData.score : -ttData.score;
+        if (ttValue > AI_MATE_SCORE) ttValue -= currDepth * 2;
+        else if (ttValue < -AI_MATE_SCORE) ttValue += currDepth * 2;
+
+        QuoridorBound bound = ttData.bound;
+        if (!maximizing && bound == QUORIDOR_BOUND_LOWER) bound = QUORIDOR_BOUND_UPPER;
+        else if (!maximizing && bound == QUORIDOR_BOUND_UPPER) bound = QUORIDOR_BOUND_LOWER;
+
+        if (bound == QUORIDOR_BOUND_EXACT ||
+            (bound == QUORIDOR_BOUND_LOWER && ttValue >= beta) ||
+            (bound == QUORIDOR_BOUND_UPPER && ttValue <= alpha))
+        {
+            AIStats_countTTCutoff(&search->stats);
+            return ttValue;
+        }
+    }
+
+    QuoridorUndo undo;
+    QuoridorTurn currTurn;
+    QuoridorTurn bestTurn = { 0 };
+    QuoridorTurn childTurn = { 0 };
+
+    QuoridorTurn children[AI_MAX_CHILDREN];
+    QuoridorTurn ttTurn = (ttHit) ? ttData.turn : (QuoridorTurn) { 0 };
+    if (currDepth == 0 && search->rootTurn.action != QUORIDOR_ACTION_UNDEFINED)
+        ttTurn = search->rootTurn;
+
+    const int childCount = QuoridorCore_generateChildren(self, playerID, ttTurn, search, children);
+
+    for (int i = 0; i < childCount; i++)
+    {
+        currTurn = children[i];
+
+        QuoridorCore_makeTurn(self, currTurn, &undo);
+        childTurn = currTurn;
+        currValue = QuoridorCore_minMax(self, playerID, currDepth + 1, maxDepth, alpha, beta, &childTurn, search);
+        QuoridorCore_unmakeTurn(self, currTurn, &undo);
+
+        if (search->stopped)
+            return 0;
 
         if ((maximizing && currValue > value) || ((!maximizing) && currValue < value))
         {
             value = currValue;
-            *turn = currTurn;
+            bestTurn = currTurn;
         }
 
         if ((maximizing && value >= beta) || (!maximizing && value <= alpha))
-            return value;
+        {
+            AIStats_countCutoff(&search->stats, i);
+            break;
+        }
 
         alpha = (alpha < value && maximizing) ? value : alpha;
         beta = (beta > value && !maximizing) ? value : beta;
+
+        // Young Brothers Wait : une fois le premier fils exploré, les suivants peuvent être partagés.
+        if (i == 0 && AIYBWC_canSplit(search, remainingDepth, childCount - 1))
+        {
+            QuoridorCore_split(
+                self, playerID, currDepth, maxDepth, children, 1, childCount,
+                &alpha, &beta, &value, &bestTurn, search);
+
+            if (search->stopped)
+                return 0;
+            break;
+        }
     }
 
-    // Murs
-    if (pos > 0)
+    if (bestTurn.action != QUORIDOR_ACTION_UNDEFINED)
+        *turn = bestTurn;
+
+    if (table != NULL && bestTurn.action != QUORIDOR_ACTION_UNDEFINED)
     {
-        qsort(list, pos, sizeof(TurnToSort), QuoridorCore_compareWall);
+        QuoridorBound bound = QUORIDOR_BOUND_EXACT;
+        if (value <= alphaOrig) bound = (maximizing) ? QUORIDOR_BOUND_UPPER : QUORIDOR_BOUND_LOWER;
+        else if (value >= betaOrig) bound = (maximizing) ? QUORIDOR_BOUND_LOWER : QUORIDOR_BOUND_UPPER;
+
+        float ttValue = (maximizing) ? value : -value;
+        if (ttValue > AI_MATE_SCORE) ttValue += currDepth * 2;
+        else if (ttValue < -AI_MATE_SCORE) ttValue -= currDepth * 2;
+
+        ttData.score = ttValue;
+        ttData.turn = bestTurn;
+        ttData.depth = remainingDepth;
+        ttData.bound = bound;
+        QuoridorTT_store(table, self->hashKey ^ search->rootKey, &ttData);
+    }
 
-        int limit = (pos < 7) ? pos : 7;
-        for (int i = 0; i < limit; i++)
-        {
-            QuoridorCore_playTurn(&gameCopy, list[i].turn);
-            childTurn = list[i].turn;
-
-            currValue = QuoridorCore_minMax(&gameCopy, playerID, currDepth + 1, maxDepth, alpha, beta, &childTurn, AIdata);
-            gameCopy = *self;
-#if DEBUG
-            movesAtDepth[currDepth]++;
-            totalValues += currValue;
-#endif
+    return value;
+}
 
-            if ((maximizing && currValue > value) || ((!maximizing) && currValue < value))
-            {
-                value = currValue;
-                *turn = list[i].turn;
-            }
+/// @brief Fils de la racine partagés entre les threads d'une recherche parallèle.
+/// Chaque thread prend le prochain fils non exploré et l'analyse sur sa propre copie du plateau.
+typedef struct AIRootSplit
+{
+    /// @brief Position de la racine (lue par tous les threads).
+    const QuoridorCore *root;
 
-            if ((maximizing && value >= beta) || (!maximizing && value <= alpha))
-                return value;
+    /// @brief Profondeur maximale de la recherche.
+    int maxDepth;
 
-            alpha = (alpha < value && maximizing) ? value : alpha;
-            beta = (beta > value && !maximizing) ? value : beta;
+    /// @brief Fils de la racine, dans l'ordre d'exploration.
+    QuoridorTurn children[AI_MAX_CHILDREN];
+
+    /// @brief Nombre de fils de la racine.
+    int childCount;
+
+    /// @brief Indice du prochain fils à explorer.
+    SDL_AtomicInt nextChild;
+
+    /// @brief Borne alpha partagée (représentation binaire d'un float).
+    /// Elle ne fait que croître : un fils exploré après un bon coup est élagué plus tôt.
+    SDL_AtomicInt alphaBits;
+
+    /// @brief Contexte de recherche de l'appelant, recopié dans chaque thread.
+    const AISearch *search;
+
+    /// @brief Mutex protégeant les champs suivants.
+    SDL_Mutex *mutex;
+
+    /// @brief Meilleure valeur trouvée.
+    float bestValue;
+
+    /// @brief Indice du meilleur fils trouvé (-1 si aucun).
+    int bestIndex;
+
+    /// @brief Nombre total de noeuds visités par les threads.
+    int nodeCount;
+
+    /// @brief Statistiques additionnées des threads.
+    AIStats stats;
+
+    /// @brief Indique si l'un des threads a été interrompu.
+    bool stopped;
+} AIRootSplit;
+
+/// @brief Données propres à un thread de la recherche parallèle.
+typedef struct AIRootWorker
+{
+    AIRootSplit *split;
+    int index;
+} AIRootWorker;
+
+static float AIRootSplit_getAlpha(AIRootSplit *self)
+{
+    int bits = SDL_GetAtomicInt(&self->alphaBits);
+    float alpha;
+    memcpy(&alpha, &bits, sizeof(alpha));
+    return alpha;
+}
+
+static void AIRootSplit_raiseAlpha(AIRootSplit *self, float value)
+{
+    int newBits;
+    memcpy(&newBits, &value, sizeof(newBits));
+    while (true)
+    {
+        int oldBits = SDL_GetAtomicInt(&self->alphaBits);
+        float alpha;
+        memcpy(&alpha, &oldBits, sizeof(alpha));
+        if (value <= alpha || SDL_CompareAndSwapAtomicInt(&self->alphaBits, oldBits, newBits))
+            break;
+    }
+}
+
+static int AIRootSplit_run(void *data)
+{
+    AIRootWorker *worker = (AIRootWorker *)data;
+    AIRootSplit *split = worker->split;
+
+    QuoridorCore board = *split->root;
+    const int playerID = board.playerID;
+
+    AISearch search = *split->search;
+    search.nodeCount = 0;
+    search.stopped = false;
+    AIStats_clear(&search.stats);
+    AISearch_seed(&search, split->search->randState + worker->index);
+
+    while (true)
+    {
+        const int i = SDL_AddAtomicInt(&split->nextChild, 1);
+        if (i >= split->childCount)
+            break;
+
+        const QuoridorTurn currTurn = split->children[i];
+        const float alpha = AIRootSplit_getAlpha(split);
+
+        QuoridorUndo undo;
+        QuoridorTurn childTurn = currTurn;
+        QuoridorCore_makeTurn(&board, currTurn, &undo);
+        const float value = QuoridorCore_minMax(
+            &board, playerID, 1, split->maxDepth, alpha, INFINITY, &childTurn, &search);
+        QuoridorCore_unmakeTurn(&board, currTurn, &undo);
+
+        if (search.stopped)
+            break;
+
+        // Une valeur inférieure ou égale à alpha n'est qu'un majorant : le fils n'est pas meilleur.
+        if (value <= alpha)
+            continue;
+
+        AIRootSplit_raiseAlpha(split, value);
+
+        // À valeur égale, le fils le plus tôt dans l'ordre d'exploration est conservé,
+        // comme dans la recherche séquentielle.
+        SDL_LockMutex(split->mutex);
+        if (split->bestIndex < 0 || value > split->bestValue
+            || (value == split->bestValue && i < split->bestIndex))
+        {
+            split->bestValue = value;
+            split->bestIndex = i;
         }
+        SDL_UnlockMutex(split->mutex);
     }
 
-    return value;
+    SDL_LockMutex(split->mutex);
+    split->nodeCount += search.nodeCount;
+    split->stopped |= search.stopped;
+    AIStats_merge(&split->stats, &search.stats);
+    SDL_UnlockMutex(split->mutex);
+
+    return 0;
+}
+
+/// @brief Explore la racine en répartissant ses fils entre plusieurs threads.
+/// Chaque fils est analysé sur une copie du plateau avec la borne alpha courante, partagée de façon atomique.
+/// @param self Position de la racine.
+/// @param maxDepth Profondeur maximale de la recherche.
+/// @param turn Adresse dans laquelle est écrit le meilleur coup trouvé.
+/// @param search Contexte de la recherche.
+/// @return L'évaluation de la racine.
+static float QuoridorCore_rootSplit(QuoridorCore *self, int maxDepth, QuoridorTurn *turn, AISearch *search)
+{
+    AIRootSplit split = { 0 };
+    split.root = self;
+    split.maxDepth = maxDepth;
+    split.search = search;
+    split.bestIndex = -1;
+    split.bestValue = -INFINITY;
+
+    const float alpha = -INFINITY;
+    int alphaBits;
+    memcpy(&alphaBits, &alpha, sizeof(alphaBits));
+    SDL_SetAtomicInt(&split.alphaBits, alphaBits);
+    SDL_SetAtomicInt(&split.nextChild, 0);
+
+    QuoridorTTData ttData = { 0 };
+    QuoridorTurn ttTurn = search->rootTurn;
+    if (ttTurn.action == QUORIDOR_ACTION_UNDEFINED && search->table
+        && QuoridorTT_probe(search->table, self->hashKey ^ search->rootKey, &ttData))
+    {
+        ttTurn = ttData.turn;
+    }
+    split.childCount = QuoridorCore_generateChildren(self, self->playerID, ttTurn, search, split.children);
+
+    split.mutex = SDL_CreateMutex();
+    AssertNew(split.mutex);
+
+    // Le thread appelant participe à la recherche.
+    const int threadCount = Int_clamp(search->threadCount, 1, Int_min(split.childCount, AI_MAX_THREADS));
+    AIRootWorker workers[AI_MAX_THREADS];
+    SDL_Thread *threads[AI_MAX_THREADS] = { 0 };
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers[i].split = &split;
+        workers[i].index = i;
+    }
+    for (int i = 1; i < threadCount; i++)
+    {
+        threads[i] = SDL_CreateThread(AIRootSplit_run, "AIRootSplit", &workers[i]);
+        AssertNew(threads[i]);
+    }
+    AIRootSplit_run(&workers[0]);
+    for (int i = 1; i < threadCount; i++)
+    {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDL_DestroyMutex(split.mutex);
+
+    search->nodeCount += split.nodeCount;
+    search->stopped |= split.stopped;
+    AIStats_countNode(&search->stats, 0);
+    AIStats_merge(&search->stats, &split.stats);
+    AISearch_seed(search, search->randState);
+
+    if (split.bestIndex >= 0)
+        *turn = split.children[split.bestIndex];
+
+    return split.bestValue;
+}
+
+/// @brief Explore l'arbre de jeu depuis la racine, avec plusieurs threads si le contexte le demande.
+/// @param self Position de la racine.
+/// @param maxDepth Profondeur maximale de la recherche.
+/// @param turn Adresse dans laquelle est écrit le meilleur coup trouvé.
+/// @param search Contexte de la recherche.
+/// @return L'évaluation de la racine.
+static float QuoridorCore_searchRoot(QuoridorCore *self, int maxDepth, QuoridorTurn *turn, AISearch *search)
+{
+    if (search->threadCount > 1)
+        return QuoridorCore_rootSplit(self, maxDepth, turn, search);
+
+    return QuoridorCore_minMax(self, self->playerID, 0, maxDepth, -INFINITY, INFINITY, turn, search);
 }
 
 QuoridorTurn QuoridorCore_computeTurn(QuoridorCore *self, int depth, void *aiData)
+{
+    AISearchParams params = { 0 };
+    params.depth = depth;
+    return QuoridorCore_computeTurnWithParams(self, &params, aiData);
+}
+
+QuoridorTurn QuoridorCore_computeTurnTimed(QuoridorCore *self, Uint64 budgetMS, void *aiData)
+{
+    AISearchParams params = { 0 };
+    params.budgetMS = budgetMS;
+    return QuoridorCore_computeTurnWithParams(self, &params, aiData);
+}
+
+/// @brief Recherche à profondeur fixe.
+static QuoridorTurn QuoridorCore_computeTurnFixed(QuoridorCore *self, int depth, AISearch *search)
 {
     QuoridorTurn childTurn = {0};
 
     if (self->state != QUORIDOR_STATE_IN_PROGRESS)
         return childTurn;
 
-    const float alpha = -INFINITY;
-    const float beta = INFINITY;
+    // La recherche modifie le plateau en place (makeTurn/unmakeTurn) :
+    // on travaille sur une unique copie pour laisser l'instance de l'appelant intacte.
+    QuoridorCore board = *self;
 
-#if DEBUG == 0
-    float childValue = QuoridorCore_minMax(self, self->playerID, 0, depth, alpha, beta, &childTurn, aiData);
-#endif
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const uint64_t nodeCount = search->stats.nodeCount;
+
+    const float value = QuoridorCore_searchRoot(&board, depth, &childTurn, search);
 
-#if DEBUG
-    float childValue = QuoridorCore_minMax(self, self->playerID, 0, 5, alpha, beta, &childTurn, aiData);
-    /*for (int i = 0; i < 10; i++)
-        printf("%d mouvements etudies a la profondeur %d\n", movesAtDepth[i], i);
 
-    printf("Total : %d noeuds\n", nodeVisited);*/
-    char action[32];
-    switch (childTurn.action)
+    // Le résultat d'une recherche interrompue n'est pas significatif.
+    if (search->stopped)
+        childTurn.action = QUORIDOR_ACTION_UNDEFINED;
+    else
     {
-    case QUORIDOR_PLAY_HORIZONTAL_WALL:
-        strcpy(action, "Mur horizontal");
-        break;
-    case QUORIDOR_PLAY_VERTICAL_WALL:
-        strcpy(action, "Mur vertical");
-        break;
-    case QUORIDOR_MOVE_TO:
-        strcpy(action, "Deplacement");
-        break;
-    default:
-        strcpy(action, "Euh..");
-        break;
+        AIStats_addIteration(&search->stats, depth, AISearch_getElapsedMS(start), search->stats.nodeCount - nodeCount);
+        AISearch_reportIteration(search, self, depth, value, childTurn);
     }
-    printf("Action jouee : %s en (%d;%d)\n", action, childTurn.j, childTurn.i);
-    printf("Valeur du coup : %f, valeur moyenne des coups evalues : %f\n", childValue, totalValues / nodeVisited);
-
-    memset(movesAtDepth, 0, sizeof(movesAtDepth));
-    nodeVisited = 0;
-    totalValues = 0;
-#endif
 
     return childTurn;
 }
+
+/// @brief Recherche par approfondissement itératif limitée en temps.
+static QuoridorTurn QuoridorCore_computeTurnIterative(QuoridorCore *self, int maxDepth, Uint64 budgetMS, AISearch *search)
+{
+    QuoridorTurn bestTurn = { 0 };
+
+    if (self->state != QUORIDOR_STATE_IN_PROGRESS)
+        return bestTurn;
+
+    const Uint64 startTime = SDL_GetTicks();
+
+    QuoridorCore board = *self;
+
+    for (int depth = 1; depth <= maxDepth; depth++)
+    {
+        // La première itération n'est jamais interrompue par l'échéance pour toujours disposer d'un coup.
+        search->deadline = (depth > 1) ? startTime + budgetMS : 0;
+
+        const Uint64 iterationStart = SDL_GetPerformanceCounter();
+        const uint64_t nodeCount = search->stats.nodeCount;
+
+        QuoridorTurn turn = { 0 };
+        float value = QuoridorCore_searchRoot(&board, depth, &turn, search);
+
+        // Les résultats d'une itération interrompue sont ignorés.
+        if (search->stopped)
+            break;
+
+        AIStats_addIteration(&search->stats, depth, AISearch_getElapsedMS(iterationStart), search->stats.nodeCount - nodeCount);
+        AISearch_reportIteration(search, self, depth, value, turn);
+
+        bestTurn = turn;
+        search->rootTurn = turn;
+
+        // Fin de partie trouvée : une recherche plus profonde ne changera pas le coup.
+        if (fabsf(value) > AI_MATE_SCORE)
+            break;
+
+        // L'itération suivante prend en général plus de temps que toutes les précédentes réunies.
+        const Uint64 elapsed = SDL_GetTicks() - startTime;
+        if (elapsed * 2 >= budgetMS)
+            break;
+    }
+
+    return bestTurn;
+}
+
+/// @brief Lance la recherche du thread principal : à profondeur fixe ou limitée en temps.
+static QuoridorTurn QuoridorCore_runSearch(QuoridorCore *self, int maxDepth, Uint64 budgetMS, AISearch *search)
+{
+    if (budgetMS == 0)
+        return QuoridorCore_computeTurnFixed(self, maxDepth, search);
+
+    return QuoridorCore_computeTurnIterative(self, maxDepth, budgetMS, search);
+}
+
+/// @brief Données partagées par les threads auxiliaires d'une recherche Lazy SMP.
+typedef struct AILazySMP
+{
+    /// @brief Position de la racine (lue par tous les threads).
+    const QuoridorCore *root;
+
+    /// @brief Copie du contexte de recherche initial du thread principal, recopiée dans chaque thread auxiliaire.
+    AISearch search;
+
+    /// @brief Profondeur maximale de l'approfondissement itératif.
+    int maxDepth;
+
+    /// @brief Drapeau d'arrêt des threads auxiliaires, levé à la fin de la recherche principale.
+    SDL_AtomicInt stopFlag;
+} AILazySMP;
+
+/// @brief Données propres à un thread auxiliaire.
+typedef struct AILazyHelper
+{
+    AILazySMP *smp;
+    int helperID;
+
+    /// @brief Statistiques du thread, lues après sa fin.
+    AIStats stats;
+} AILazyHelper;
+
+static int AILazySMP_run(void *data)
+{
+    AILazyHelper *helper = (AILazyHelper *)data;
+    AILazySMP *smp = helper->smp;
+
+    QuoridorCore board = *smp->root;
+
+    AISearch search = smp->search;
+    search.stopFlag = &smp->stopFlag;
+    search.deadline = 0;
+    search.threadCount = 1;
+    search.helperID = helper->helperID;
+    search.nodeCount = 0;
+    search.stopped = false;
+    AIStats_clear(&search.stats);
+    AISearch_seed(&search, smp->search.randState + helper->helperID);
+
+    // Un auxiliaire sur deux a une itération d'avance sur le thread principal :
+    // ses résultats plus profonds sont disponibles dans la table quand celui-ci les atteint.
+    for (int depth = 1 + (helper->helperID & 1); depth <= smp->maxDepth; depth++)
+    {
+        QuoridorTurn turn = { 0 };
+        QuoridorCore_minMax(&board, board.playerID, 0, depth, -INFINITY, INFINITY, &turn, &search);
+        if (search.stopped)
+            break;
+
+        search.rootTurn = turn;
+    }
+
+    helper->stats = search.stats;
+    return 0;
+}
+
+/// @brief Recherche Lazy SMP.
+/// Les threads auxiliaires mènent leur propre approfondissement itératif sur la table partagée
+/// jusqu'à la fin de la recherche du thread principal, dont le résultat est renvoyé.
+static QuoridorTurn QuoridorCore_lazySMP(QuoridorCore *self, int maxDepth, Uint64 budgetMS, AISearch *search)
+{
+    AILazySMP smp = { 0 };
+    smp.root = self;
+    smp.search = *search;
+    smp.maxDepth = maxDepth;
+    SDL_SetAtomicInt(&smp.stopFlag, 0);
+
+    const int helperCount = search->threadCount - 1;
+    AILazyHelper helpers[AI_MAX_THREADS];
+    SDL_Thread *threads[AI_MAX_THREADS] = { 0 };
+    for (int i = 0; i < helperCount; i++)
+    {
+        helpers[i].smp = &smp;
+        helpers[i].helperID = i + 1;
+        threads[i] = SDL_CreateThread(AILazySMP_run, "AILazySMP", &helpers[i]);
+        AssertNew(threads[i]);
+    }
+
+    // Le thread principal ne répartit pas lui-même ses fils.
+    search->threadCount = 1;
+    QuoridorTurn turn = QuoridorCore_runSearch(self, maxDepth, budgetMS, search);
+
+    SDL_SetAtomicInt(&smp.stopFlag, 1);
+    for (int i = 0; i < helperCount; i++)
+    {
+        SDL_WaitThread(threads[i], NULL);
+        AIStats_merge(&search->stats, &helpers[i].stats);
+    }
+
+    return turn;
+}
+
+/// @brief Recherche parallèle YBWC.
+/// Le thread appelant mène la recherche ; les threads auxiliaires attendent qu'un noeud soit partagé.
+static QuoridorTurn QuoridorCore_ybwc(QuoridorCore *self, int maxDepth, Uint64 budgetMS, AISearch *search)
+{
+    AIYBWC ybwc = { 0 };
+    ybwc.mutex = SDL_CreateMutex();
+    AssertNew(ybwc.mutex);
+    ybwc.condition = SDL_CreateCondition();
+    AssertNew(ybwc.condition);
+    ybwc.threadCount = search->threadCount;
+    SDL_SetAtomicInt(&ybwc.idleCount, 0);
+
+    search->ybwc = &ybwc;
+    search->threadIndex = 0;
+    search->threadCount = 1;
+
+    AISearch helpers[AI_MAX_THREADS];
+    SDL_Thread *threads[AI_MAX_THREADS] = { 0 };
+    for (int i = 1; i < ybwc.threadCount; i++)
+    {
+        helpers[i] = *search;
+        helpers[i].threadIndex = i;
+        helpers[i].nodeCount = 0;
+        AIStats_clear(&helpers[i].stats);
+        AISearch_seed(&helpers[i], search->randState + i);
+        threads[i] = SDL_CreateThread(AIYBWC_run, "AIYBWC", &helpers[i]);
+        AssertNew(threads[i]);
+    }
+
+    QuoridorTurn turn = QuoridorCore_runSearch(self, maxDepth, budgetMS, search);
+
+    SDL_LockMutex(ybwc.mutex);
+    ybwc.quit = true;
+    SDL_BroadcastCondition(ybwc.condition);
+    SDL_UnlockMutex(ybwc.mutex);
+    for (int i = 1; i < ybwc.threadCount; i++)
+    {
+        SDL_WaitThread(threads[i], NULL);
+        AIStats_merge(&search->stats, &helpers[i].stats);
+    }
+
+    SDL_DestroyCondition(ybwc.condition);
+    SDL_DestroyMutex(ybwc.mutex);
+    search->ybwc = NULL;
+
+    return turn;
+}
+
+/// @brief Recherche Monte-Carlo, avec l'arbre des données de l'IA s'il y en a.
+static QuoridorTurn QuoridorCore_computeTurnMCTS(QuoridorCore *self, const AISearchParams *params, void *aiData)
+{
+    if (aiData == NULL)
+    {
+        MCTSTree *tree = MCTSTree_create(MCTS_DEFAULT_CAPACITY);
+        QuoridorTurn turn = MCTSTree_search(tree, self, params);
+        MCTSTree_destroy(tree);
+        return turn;
+    }
+
+    AIData *data = (AIData *)aiData;
+    if (data->mcts == NULL)
+        data->mcts = MCTSTree_create(MCTS_DEFAULT_CAPACITY);
+
+    return MCTSTree_search(data->mcts, self, params);
+}
+
+/// @brief Renvoie le cache des analyses utilisable par une recherche :
+/// celui des paramètres, ou à défaut celui des données de l'IA.
+/// Les analyses enregistrées ne valent que pour une position en cours et pour l'évaluation par défaut.
+static AICache *QuoridorCore_getCache(QuoridorCore *self, const AISearchParams *params, void *aiData)
+{
+    AICache *cache = params->cache;
+    if (cache == NULL && aiData)
+        cache = ((AIData *)aiData)->cache;
+
+    if (cache == NULL || self->state != QUORIDOR_STATE_IN_PROGRESS)
+        return NULL;
+    if (params->weights && params->weights != &AIEvalWeights_default)
+        return NULL;
+    return cache;
+}
+
+QuoridorTurn QuoridorCore_computeTurnWithParams(QuoridorCore *self, const AISearchParams *params, void *aiData)
+{
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const int threadCount = Int_clamp(params->threadCount, 1, AI_MAX_THREADS);
+    const uint64_t seed = params->seed ^ (uint64_t)(Uint32)SDL_AddAtomicInt(&s_searchCount, 1);
+
+    // Les premiers tours sont lus dans le livre d'ouvertures.
+    const QuoridorBook *book = params->book;
+    if (book == NULL && aiData)
+        book = ((AIData *)aiData)->book;
+
+    QuoridorTurn bookTurn;
+    if (book && self->state == QUORIDOR_STATE_IN_PROGRESS
+        && QuoridorBook_probe(book, self, AI_mixSeed(seed), &bookTurn))
+    {
+        if (params->stats)
+        {
+            AIStats_clear(params->stats);
+            params->stats->totalMS = AISearch_getElapsedMS(start);
+            params->stats->threadCount = threadCount;
+        }
+        return bookTurn;
+    }
+
+    if (params->engine == AI_ENGINE_MCTS)
+    {
+        QuoridorTurn turn = QuoridorCore_computeTurnMCTS(self, params, aiData);
+        if (params->stats)
+        {
+            AIStats_clear(params->stats);
+            params->stats->totalMS = AISearch_getElapsedMS(start);
+            params->stats->threadCount = threadCount;
+        }
+        return turn;
+    }
+
+    // Une position déjà analysée assez profondément n'est pas recherchée à nouveau.
+    // Une recherche à profondeur fixe n'utilise que les analyses de cette profondeur exacte :
+    // une analyse plus profonde jouerait mieux que ce qui est demandé.
+    AICache *cache = QuoridorCore_getCache(self, params, aiData);
+    if (cache)
+    {
+        int requiredDepth = params->depth;
+        if (params->budgetMS > 0 && params->depth <= 0)
+            requiredDepth = AI_CACHE_TIMED_DEPTH;
+
+        AICacheData cacheData = { 0 };
+        const bool found = AICache_probe(cache, self->hashKey, &cacheData);
+        const bool deepEnough = (params->budgetMS > 0)
+            ? cacheData.depth >= requiredDepth : cacheData.depth == requiredDepth;
+        if (found && deepEnough && QuoridorCore_canPlayTurn(self, cacheData.turn))
+        {
+            if (params->stats)
+            {
+                AIStats_clear(params->stats);
+                params->stats->totalMS = AISearch_getElapsedMS(start);
+                params->stats->threadCount = threadCount;
+            }
+            return cacheData.turn;
+        }
+    }
+
+    AISearch search = { 0 };
+    search.table = AIData_getTable(aiData);
+    search.rootKey = (self->playerID == 1) ? AI_TT_ROOT_PLAYER_KEY : 0;
+    search.stopFlag = params->stopFlag;
+    search.threadCount = threadCount;
+    search.onIteration = params->onIteration;
+    search.userData = params->userData;
+    search.startCounter = start;
+    search.weights = params->weights ? params->weights : &AIEvalWeights_default;
+    AISearch_seed(&search, seed);
+    if (search.table) QuoridorTT_newSearch(search.table);
+
+    int maxDepth = params->depth;
+    if (params->budgetMS > 0)
+        maxDepth = (params->depth > 0) ? Int_min(params->depth, AI_MAX_DEPTH) : AI_MAX_DEPTH;
+
+    QuoridorTurn turn;
+
+    // Sans table de transposition, les threads auxiliaires ne peuvent rien transmettre.
+    if (search.threadCount > 1 && params->parallelMode == AI_PARALLEL_LAZY_SMP
+        && search.table && self->state == QUORIDOR_STATE_IN_PROGRESS)
+    {
+        turn = QuoridorCore_lazySMP(self, maxDepth, params->budgetMS, &search);
+    }
+    else if (search.threadCount > 1 && params->parallelMode == AI_PARALLEL_YBWC
+        && self->state == QUORIDOR_STATE_IN_PROGRESS)
+    {
+        turn = QuoridorCore_ybwc(self, maxDepth, params->budgetMS, &search);
+    }
+    else
+    {
+        turn = QuoridorCore_runSearch(self, maxDepth, params->budgetMS, &search);
+    }
+
+    // Seul le résultat d'une itération terminée est enregistré.
+    if (cache && search.completedDepth > 0 && turn.action != QUORIDOR_ACTION_UNDEFINED)
+    {
+        AICacheData cacheData = { 0 };
+        cacheData.score = search.completedScore;
+        cacheData.turn = turn;
+        cacheData.depth = search.completedDepth;
+        AICache_store(cache, self->hashKey, &cacheData);
+    }
+
+    search.stats.totalMS = AISearch_getElapsedMS(start);
+    search.stats.threadCount = threadCount;
+    if (params->stats)
+        *params->stats = search.stats;
+
+    return turn;
+}
@@ -6,8 +6,12 @@
 
 #pragma once
 
-#include "settings.h"
+#include "core/core_settings.h"
 #include "core/quoridor_core.h"
+#include "core/quoridor_path.h"
+#include "core/quoridor_stats.h"
+#include "core/quoridor_ai_cache.h"
+#include "core/quoridor_book.h"
 
 /// @brief Crée les données utilisées par l'IA.
 /// @param core Instance du jeu Quoridor.
@@ -23,6 +27,20 @@ void AIData_destroy(void *self);
 /// @param self Pointeur vers les données de l'IA.
 void AIData_reset(void *self);
 
+/// @brief Associe un cache des analyses aux données de l'IA.
+/// Les recherches dont les paramètres ne donnent pas de cache utilisent celui-ci,
+/// en particulier QuoridorCore_computeTurn() et QuoridorCore_computeTurnTimed().
+/// @param self Pointeur vers les données de l'IA.
+/// @param cache Cache des analyses (peut être NULL). Il doit rester ouvert tant qu'il est associé.
+void AIData_setCache(void *self, AICache *cache);
+
+/// @brief Associe un livre d'ouvertures aux données de l'IA.
+/// Les recherches dont les paramètres ne donnent pas de livre utilisent celui-ci,
+/// en particulier QuoridorCore_computeTurn() et QuoridorCore_computeTurnTimed().
+/// @param self Pointeur vers les données de l'IA.
+/// @param book Livre d'ouvertures (peut être NULL). Il doit rester ouvert tant qu'il est associé.
+void AIData_setBook(void *self, const QuoridorBook *book);
+
 /// @brief Calcule une heuristique d'évaluation de l'état du jeu pour un joueur donné.
 /// Cette fonction est utilisée dans l'algorithme Min-Max pour estimer la qualité d'une position.
 /// Elle retourne une valeur représentant l'avantage du joueur playerID.
@@ -32,6 +50,14 @@ void AIData_reset(void *self);
 /// @return Une estimation numérique de l'avantage du joueur playerID.
 float QuoridorCore_computeScore(QuoridorCore* self, int playerID, QuoridorTurn turn);
 
+/// @brief Calcule l'heuristique d'évaluation de QuoridorCore_computeScore() sans son bruit aléatoire.
+/// Contrairement à QuoridorCore_computeScore(), qui utilise rand(), elle peut être appelée
+/// depuis plusieurs threads à la fois et son résultat est reproductible.
+/// @param self Instance du jeu Quoridor.
+/// @param playerID Indice du joueur à évaluer (0 ou 1).
+/// @return Une estimation numérique de l'avantage du joueur playerID.
+float QuoridorCore_computeStaticScore(QuoridorCore *self, int playerID, QuoridorTurn turn);
+
 
 /// @brief Calcule le coup joué par l'IA selon un algorithme de type min-max.
 /// @param self Instance du jeu Quoridor.
@@ -40,15 +66,184 @@ float QuoridorCore_computeScore(QuoridorCore* self, int playerID, QuoridorTurn t
 /// @return Le tour choisi par l'IA.
 QuoridorTurn QuoridorCore_computeTurn(QuoridorCore *self, int depth, void *aiData);
 
-/// @brief Calcule le plus court chemin entre la position du joueur et sa zone d'arrivée.
+/// @brief Calcule le coup joué par l'IA en un temps limité.
+/// La recherche min-max est relancée avec une profondeur croissante (approfondissement itératif),
+/// chaque itération explorant d'abord le meilleur coup de la précédente.
+/// Lorsque le temps est écoulé, le coup de la dernière itération terminée est renvoyé.
+/// La première itération (profondeur 1) est toujours menée à son terme.
 /// @param self Instance du jeu Quoridor.
-/// @param playerID Identifiant du joueur (0 ou 1).
-/// @param path Tableau (préalloué, taille MAX_PATH_LEN) dans lequel sera écrit le plus court chemin.
-///     La position finale (dans la zone de victoire) est stockée à l'indice 0,
-///     et la position actuelle du joueur à l'indice (size - 1).
-/// @param size Adresse d'un entier dans lequel sera écrite la taille du chemin.
-///     La distance est alors égale à (size - 1).
-void QuoridorCore_getShortestPath(QuoridorCore *self, int playerID, QuoridorPos *path, int *size);
+/// @param budgetMS Temps de calcul alloué, en millisecondes.
+/// @param aiData Pointeur vers les données de l'IA.
+/// @return Le tour choisi par l'IA.
+QuoridorTurn QuoridorCore_computeTurnTimed(QuoridorCore *self, Uint64 budgetMS, void *aiData);
+
+/// @brief Répartition d'une recherche entre plusieurs threads.
+typedef enum AIParallelMode
+{
+    /// @brief Les fils de la racine sont répartis entre les threads.
+    AI_PARALLEL_ROOT_SPLIT,
+
+    /// @brief Lazy SMP : des threads auxiliaires mènent la même recherche par approfondissement itératif
+    /// avec un ordre des coups différent et alimentent la table de transposition partagée.
+    /// Le coup renvoyé est celui du thread appelant.
+    AI_PARALLEL_LAZY_SMP,
+
+    /// @brief Young Brothers Wait : à chaque noeud, le premier fils est exploré par un seul thread,
+    /// puis les fils suivants sont partagés avec les threads inoccupés.
+    /// Adapté aux recherches profondes, y compris lorsque la racine a peu de fils.
+    /// Un thread qui attend la fin des fils qu'il a partagés aide les threads qui les explorent.
+    AI_PARALLEL_YBWC,
+} AIParallelMode;
+
+/// @brief Algorithme utilisé par l'IA.
+typedef enum AIEngine
+{
+    /// @brief Recherche min-max avec élagage alpha-bêta et heuristique d'évaluation.
+    AI_ENGINE_MINMAX,
+
+    /// @brief Recherche arborescente Monte-Carlo (UCT) avec simulations gloutonnes.
+    AI_ENGINE_MCTS,
+} AIEngine;
+
+/// @brief Longueur maximale de la variante principale transmise à la fin d'une itération.
+#define AI_MAX_PV_LENGTH 32
+
+/// @brief Score au-delà duquel une évaluation correspond à une fin de partie trouvée par la recherche.
+/// Le score d'une victoire en n tours (du point de vue du joueur qui cherche) vaut 10000 - 2n.
+#define AI_MATE_SCORE 9500.0f
+
+/// @brief Résultat d'une itération terminée de la recherche min-max.
+typedef struct AIIterationInfo
+{
+    /// @brief Profondeur de l'itération.
+    int depth;
+
+    /// @brief Évaluation de la position, du point de vue du joueur qui cherche son coup.
+    /// Au-delà de AI_MATE_SCORE en valeur absolue, une fin de partie a été trouvée.
+    float score;
+
+    /// @brief Nombre de noeuds visités par le thread appelant depuis le début de la recherche.
+    int nodeCount;
+
+    /// @brief Temps écoulé depuis le début de la recherche, en millisecondes.
+    double elapsedMS;
+
+    /// @brief Variante principale : meilleur coup puis meilleure suite prévue,
+    /// lue dans la table de transposition (limitée au premier coup sans table).
+    QuoridorTurn pv[AI_MAX_PV_LENGTH];
+
+    /// @brief Nombre de tours de la variante principale.
+    int pvLength;
+} AIIterationInfo;
+
+/// @brief Profondeur minimale d'une analyse du cache utilisée par une recherche limitée en temps seulement.
+#define AI_CACHE_TIMED_DEPTH 6
+
+/// @brief Poids des termes de l'heuristique d'évaluation de la recherche min-max.
+/// Ils permettent de comparer plusieurs réglages de l'évaluation (voir l'outil quoridor_selfplay).
+typedef struct AIEvalWeights
+{
+    /// @brief Différence entre les longueurs des plus courts chemins des deux joueurs.
+    float pathDifference;
+
+    /// @brief Nombre de cases que le joueur n'a plus à parcourir (sur 17).
+    float pathLength;
+
+    /// @brief Pénalité lorsque l'adversaire a un chemin court et se trouve près du départ du joueur.
+    float threat;
+
+    /// @brief Nombre de murs restants.
+    float wallCount;
+
+    /// @brief Distance des pions au centre du plateau, lorsque leur chemin est encore long.
+    float center;
+
+    /// @brief Bonus d'un mur posé alors que l'adversaire est encore proche de son départ.
+    float earlyWall;
+} AIEvalWeights;
+
+/// @brief Poids utilisés par défaut par l'heuristique d'évaluation.
+extern const AIEvalWeights AIEvalWeights_default;
+
+/// @brief Fonction appelée par le thread de la recherche à la fin de chaque itération.
+/// @param userData Pointeur transmis avec les paramètres de la recherche.
+/// @param info Résultat de l'itération.
+typedef void (*AIIterationCallback)(void *userData, const AIIterationInfo *info);
+
+/// @brief Paramètres d'une recherche de l'IA.
+typedef struct AISearchParams
+{
+    /// @brief Algorithme de recherche.
+    AIEngine engine;
+
+    /// @brief Profondeur de la recherche.
+    /// Avec un budget de temps, profondeur maximale de l'approfondissement itératif (0 : aucune limite).
+    int depth;
+
+    /// @brief Temps de calcul alloué, en millisecondes.
+    /// Vaut 0 pour une recherche à profondeur fixe.
+    Uint64 budgetMS;
+
+    /// @brief Nombre maximal de simulations (MCTS uniquement, 0 : aucune limite).
+    /// Sans budget de temps ni nombre de simulations, une valeur par défaut est utilisée.
+    int playoutCount;
+
+    /// @brief Drapeau d'arrêt (peut être NULL).
+    /// La recherche s'interrompt peu après qu'un autre thread lui a donné une valeur non nulle ;
+    /// le tour renvoyé est alors celui de la dernière itération terminée (éventuellement indéfini).
+    SDL_AtomicInt *stopFlag;
+
+    /// @brief Nombre de threads de la recherche (0 ou 1 : recherche séquentielle).
+    /// Le thread appelant est l'un d'eux.
+    int threadCount;
+
+    /// @brief Répartition de la recherche entre les threads.
+    AIParallelMode parallelMode;
+
+    /// @brief Adresse dans laquelle sont écrites les statistiques de la recherche (peut être NULL).
+    /// Les compteurs de tous les threads sont additionnés. Sans l'option AI_STATS (voir core/quoridor_stats.h)
+    /// ou avec AI_ENGINE_MCTS, seuls la durée et le nombre de threads sont renseignés.
+    AIStats *stats;
+
+    /// @brief Fonction appelée à la fin de chaque itération terminée (peut être NULL, min-max uniquement).
+    AIIterationCallback onIteration;
+
+    /// @brief Pointeur transmis à onIteration.
+    void *userData;
+
+    /// @brief Poids de l'heuristique d'évaluation (NULL : AIEvalWeights_default, min-max uniquement).
+    /// La table de transposition des données de l'IA ne doit servir qu'à un seul jeu de poids.
+    const AIEvalWeights *weights;
+
+    /// @brief Graine du tirage dans le livre d'ouvertures et du bruit de l'évaluation (min-max)
+    /// ou des simulations (MCTS).
+    /// Elle est combinée avec le numéro de la recherche (de l'arbre MCTS) dans le programme : deux recherches successives
+    /// ne tirent pas le même bruit, et une suite de recherches sur un seul thread est reproductible.
+    uint64_t seed;
+
+    /// @brief Analyses persistantes consultées avant la recherche (min-max avec les poids par défaut uniquement).
+    /// NULL : le cache associé aux données de l'IA par AIData_setCache(), s'il y en a un.
+    /// Si la position y a été analysée à la profondeur demandée (au moins à cette profondeur avec un budget
+    /// de temps, au moins à AI_CACHE_TIMED_DEPTH sans limite de profondeur), le tour enregistré est renvoyé
+    /// sans recherche. Sinon, le résultat de la recherche y est ajouté.
+    AICache *cache;
+
+    /// @brief Livre d'ouvertures consulté avant toute recherche (tous les algorithmes).
+    /// NULL : le livre associé aux données de l'IA par AIData_setBook(), s'il y en a un.
+    /// Si la position y figure, un de ses tours est tiré selon les poids du livre et renvoyé sans recherche.
+    const QuoridorBook *book;
+} AISearchParams;
+
+/// @brief Calcule le coup joué par l'IA selon les paramètres donnés.
+/// QuoridorCore_computeTurn() et QuoridorCore_computeTurnTimed() sont des cas particuliers de cette fonction.
+/// Avec AI_ENGINE_MCTS, seuls le budget de temps, le nombre de simulations, le nombre de threads,
+/// le drapeau d'arrêt, la graine et le livre d'ouvertures sont utilisés.
+/// Les données de l'IA ne doivent pas être utilisées par un autre thread pendant la recherche.
+/// @param self Instance du jeu Quoridor.
+/// @param params Paramètres de la recherche.
+/// @param aiData Pointeur vers les données de l'IA.
+/// @return Le tour choisi par l'IA.
+QuoridorTurn QuoridorCore_computeTurnWithParams(QuoridorCore *self, const AISearchParams *params, void *aiData);
 
 /// @brief Fonction spécifique à l'évaluation sur Moodle.
 /// Calcule le coup joué par l'IA avec une profondeur de 2.
@@ -0,0 +1,151 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/quoridor_ai_analysis.h"
+#include "core/utils.h"
+
+typedef enum AIAnalysisState
+{
+    AI_ANALYSIS_PENDING = 0,
+    AI_ANALYSIS_RUNNING,
+    AI_ANALYSIS_DONE,
+} AIAnalysisState;
+
+/// @brief Réserve le prochain tour à analyser : le tour prioritaire s'il est en attente,
+/// sinon le suivant dans l'ordre de la partie.
+/// @return L'indice du tour réservé, ou -1 s'il n'y a plus rien à analyser.
+static int AIAnalysis_claimPly(AIAnalysis *self)
+{
+    const int plyCount = self->m_index->turnCount;
+    while (!SDL_GetAtomicInt(&self->m_stopFlag))
+    {
+        const int priority = SDL_GetAtomicInt(&self->m_priorityPly);
+        if (priority >= 0 && priority < plyCount &&
+            SDL_CompareAndSwapAtomicInt(&self->m_states[priority], AI_ANALYSIS_PENDING, AI_ANALYSIS_RUNNING))
+        {
+            return priority;
+        }
+
+        const int ply = SDL_AddAtomicInt(&self->m_nextPly, 1);
+        if (ply >= plyCount)
+            return -1;
+
+        // Le tour a pu être réservé en priorité par un autre thread.
+        if (SDL_CompareAndSwapAtomicInt(&self->m_states[ply], AI_ANALYSIS_PENDING, AI_ANALYSIS_RUNNING))
+            return ply;
+    }
+    return -1;
+}
+
+static int AIAnalysis_run(void *data)
+{
+    AIAnalysis *self = (AIAnalysis *)data;
+    void *aiData = AIData_create(NULL);
+
+    int ply;
+    while ((ply = AIAnalysis_claimPly(self)) >= 0)
+    {
+        QuoridorCore core;
+        QuoridorRecordIndex_getPosition(self->m_index, ply, &core);
+        const QuoridorTurn played = self->m_index->turns[ply];
+
+        QuoridorTurn bestTurn = QuoridorCore_computeTurnWithParams(&core, &self->m_params, aiData);
+
+        // Une recherche interrompue n'a pas de résultat fiable.
+        if (SDL_GetAtomicInt(&self->m_stopFlag))
+            break;
+
+        AIPlyAnalysis *result = &self->m_results[ply];
+        result->bestTurn = bestTurn;
+
+        QuoridorCore gameCopy = core;
+        QuoridorCore_playTurn(&gameCopy, played);
+        result->playedScore = QuoridorCore_computeStaticScore(&gameCopy, core.playerID, played);
+
+        gameCopy = core;
+        QuoridorCore_playTurn(&gameCopy, bestTurn);
+        result->bestScore = QuoridorCore_computeStaticScore(&gameCopy, core.playerID, bestTurn);
+
+        // Publie le résultat (les opérations atomiques de SDL sont des barrières complètes).
+        SDL_SetAtomicInt(&self->m_states[ply], AI_ANALYSIS_DONE);
+        SDL_AddAtomicInt(&self->m_doneCount, 1);
+    }
+
+    AIData_destroy(aiData);
+    return 0;
+}
+
+AIAnalysis *AIAnalysis_create(const QuoridorRecordIndex *index, const AISearchParams *params, int threadCount)
+{
+    assert(index && params);
+
+    AIAnalysis *self = (AIAnalysis *)calloc(1, sizeof(AIAnalysis));
+    AssertNew(self);
+
+    const int plyCount = index->turnCount;
+    self->m_index = index;
+    self->m_params = *params;
+    self->m_params.stopFlag = &self->m_stopFlag;
+    self->m_params.threadCount = 1;
+
+    self->m_results = (AIPlyAnalysis *)calloc(plyCount > 0 ? plyCount : 1, sizeof(AIPlyAnalysis));
+    AssertNew(self->m_results);
+    self->m_states = (SDL_AtomicInt *)calloc(plyCount > 0 ? plyCount : 1, sizeof(SDL_AtomicInt));
+    AssertNew(self->m_states);
+
+    SDL_SetAtomicInt(&self->m_nextPly, 0);
+    SDL_SetAtomicInt(&self->m_priorityPly, -1);
+    SDL_SetAtomicInt(&self->m_doneCount, 0);
+    SDL_SetAtomicInt(&self->m_stopFlag, 0);
+
+    threadCount = Int_clamp(threadCount, 1, AI_ANALYSIS_MAX_THREADS);
+    threadCount = Int_min(threadCount, plyCount);
+    for (int i = 0; i < threadCount; i++)
+    {
+        self->m_threads[i] = SDL_CreateThread(AIAnalysis_run, "AIAnalysis", self);
+        AssertNew(self->m_threads[i]);
+    }
+    self->m_threadCount = threadCount;
+
+    return self;
+}
+
+void AIAnalysis_destroy(AIAnalysis *self)
+{
+    if (!self) return;
+
+    SDL_SetAtomicInt(&self->m_stopFlag, 1);
+    for (int i = 0; i < self->m_threadCount; i++)
+    {
+        SDL_WaitThread(self->m_threads[i], NULL);
+    }
+
+    free(self->m_results);
+    free(self->m_states);
+    free(self);
+}
+
+bool AIAnalysis_getResult(AIAnalysis *self, int ply, AIPlyAnalysis *result)
+{
+    assert(self && "The AIAnalysis must be created");
+    if (ply < 0 || ply >= self->m_index->turnCount) return false;
+    if (SDL_GetAtomicInt(&self->m_states[ply]) != AI_ANALYSIS_DONE) return false;
+
+    *result = self->m_results[ply];
+    return true;
+}
+
+void AIAnalysis_prioritize(AIAnalysis *self, int ply)
+{
+    assert(self && "The AIAnalysis must be created");
+    SDL_SetAtomicInt(&self->m_priorityPly, ply);
+}
+
+int AIAnalysis_getDoneCount(AIAnalysis *self)
+{
+    assert(self && "The AIAnalysis must be created");
+    return SDL_GetAtomicInt(&self->m_doneCount);
+}
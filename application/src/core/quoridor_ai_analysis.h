@@ -0,0 +1,101 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_ai.h"
+#include "core/quoridor_record.h"
+
+/// @brief Nombre maximal de threads d'une analyse.
+#define AI_ANALYSIS_MAX_THREADS 64
+
+/// @brief Résultat de l'analyse d'un tour d'une partie.
+typedef struct AIPlyAnalysis
+{
+    /// @brief Meilleur tour trouvé par l'IA depuis la position précédant le tour joué.
+    QuoridorTurn bestTurn;
+
+    /// @brief Score (QuoridorCore_computeStaticScore()) du tour joué, pour le joueur qui l'a joué.
+    float playedScore;
+
+    /// @brief Score du meilleur tour, pour le même joueur.
+    float bestScore;
+} AIPlyAnalysis;
+
+/// @brief Analyse en arrière-plan de tous les tours d'une partie indexée.
+/// Les tours sont répartis entre plusieurs threads, chacun effectuant des recherches
+/// mono-thread avec ses propres données de l'IA. Les résultats sont consultés sans attente
+/// avec AIAnalysis_getResult() ; un tour peut être analysé en priorité avec AIAnalysis_prioritize().
+typedef struct AIAnalysis
+{
+    /// @brief Threads exécutant les recherches.
+    SDL_Thread *m_threads[AI_ANALYSIS_MAX_THREADS];
+    int m_threadCount;
+
+    /// @brief Partie analysée (non copiée : l'index doit rester valide jusqu'à la destruction).
+    const QuoridorRecordIndex *m_index;
+
+    /// @brief Paramètres des recherches (le drapeau d'arrêt est fourni par l'analyse).
+    AISearchParams m_params;
+
+    /// @brief Résultat de chaque tour, valide lorsque l'état du tour vaut AI_ANALYSIS_DONE.
+    AIPlyAnalysis *m_results;
+
+    /// @brief État de chaque tour (en attente, en cours ou terminé).
+    SDL_AtomicInt *m_states;
+
+    /// @brief Prochain tour à analyser dans l'ordre de la partie.
+    SDL_AtomicInt m_nextPly;
+
+    /// @brief Tour à analyser avant les autres, ou -1.
+    SDL_AtomicInt m_priorityPly;
+
+    /// @brief Nombre de tours analysés.
+    SDL_AtomicInt m_doneCount;
+
+    /// @brief Drapeau d'arrêt transmis aux recherches en cours.
+    SDL_AtomicInt m_stopFlag;
+} AIAnalysis;
+
+/// @brief Crée une analyse et démarre ses threads.
+/// @param index Partie à analyser.
+/// @param params Paramètres de chaque recherche (threadCount est ignoré : une recherche par thread).
+/// @param threadCount Nombre de threads (borné par AI_ANALYSIS_MAX_THREADS et par le nombre de tours).
+/// @return Un pointeur vers l'analyse créée.
+AIAnalysis *AIAnalysis_create(const QuoridorRecordIndex *index, const AISearchParams *params, int threadCount);
+
+/// @brief Interrompt les recherches en cours, attend la fin des threads et détruit l'analyse.
+/// @param self Analyse à détruire (peut être NULL).
+void AIAnalysis_destroy(AIAnalysis *self);
+
+/// @brief Récupère le résultat d'un tour s'il est disponible.
+/// Cette fonction ne bloque pas.
+/// @param self Analyse.
+/// @param ply Indice du tour dans la partie.
+/// @param result Adresse dans laquelle est écrit le résultat.
+/// @return true si le tour est analysé, false sinon.
+bool AIAnalysis_getResult(AIAnalysis *self, int ply, AIPlyAnalysis *result);
+
+/// @brief Demande que le tour donné soit le prochain analysé.
+/// @param self Analyse.
+/// @param ply Indice du tour dans la partie.
+void AIAnalysis_prioritize(AIAnalysis *self, int ply);
+
+/// @brief Renvoie le nombre de tours déjà analysés.
+/// @param self Analyse.
+/// @return Le nombre de tours analysés.
+int AIAnalysis_getDoneCount(AIAnalysis *self);
+
+/// @brief Renvoie le nombre total de tours à analyser.
+/// @param self Analyse.
+/// @return Le nombre de tours de la partie.
+INLINE int AIAnalysis_getPlyCount(AIAnalysis *self)
+{
+    assert(self && "The AIAnalysis must be created");
+    return self->m_index->turnCount;
+}
@@ -0,0 +1,142 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/quoridor_ai_cache.h"
+#include "core/utils.h"
+
+// Organisation des 64 bits de AICacheEntry.data :
+// [0, 32) score (float) | [32, 42) tour | [42, 50) profondeur | [50, 64) réservé
+#define AI_CACHE_TURN_SHIFT 32
+#define AI_CACHE_DEPTH_SHIFT 42
+
+static uint64_t AICache_pack(const AICacheData *data)
+{
+    uint32_t scoreBits;
+    memcpy(&scoreBits, &data->score, sizeof(scoreBits));
+
+    const uint64_t turnBits = ((uint64_t)(data->turn.action & 3) << 8)
+        | ((uint64_t)(data->turn.i & 15) << 4)
+        | (uint64_t)(data->turn.j & 15);
+
+    return (uint64_t)scoreBits
+        | (turnBits << AI_CACHE_TURN_SHIFT)
+        | ((uint64_t)Int_clamp(data->depth, 1, 255) << AI_CACHE_DEPTH_SHIFT);
+}
+
+static void AICache_unpack(uint64_t bits, AICacheData *data)
+{
+    uint32_t scoreBits = (uint32_t)bits;
+    memcpy(&data->score, &scoreBits, sizeof(scoreBits));
+
+    const int turnBits = (int)((bits >> AI_CACHE_TURN_SHIFT) & 0x3FF);
+    data->turn.action = (QuoridorAction)(turnBits >> 8);
+    data->turn.i = (turnBits >> 4) & 15;
+    data->turn.j = turnBits & 15;
+
+    data->depth = (int)((bits >> AI_CACHE_DEPTH_SHIFT) & 0xFF);
+}
+
+AICache *AICache_create(const char *path)
+{
+    const size_t bucketCount = (size_t)1 << AI_CACHE_LOG2_BUCKET_COUNT;
+    const size_t size = AI_CACHE_HEADER_SIZE + bucketCount * sizeof(AICacheBucket);
+
+    QuoridorFileMap *map = QuoridorFileMap_create(path, size, true);
+    if (map == NULL) return NULL;
+
+    AICache *self = (AICache *)calloc(1, sizeof(AICache));
+    AssertNew(self);
+
+    self->m_map = map;
+    self->m_buckets = (AICacheBucket *)((uint8_t *)map->data + AI_CACHE_HEADER_SIZE);
+    self->m_indexMask = bucketCount - 1;
+
+    // Un fichier neuf (rempli de zéros) ou d'un autre format est réinitialisé.
+    AICacheHeader *header = (AICacheHeader *)map->data;
+    if (memcmp(header->magic, "QAC", 3) != 0 || header->version != AI_CACHE_VERSION
+        || header->log2BucketCount != AI_CACHE_LOG2_BUCKET_COUNT)
+    {
+        memset(map->data, 0, size);
+        memcpy(header->magic, "QAC", 3);
+        header->version = AI_CACHE_VERSION;
+        header->log2BucketCount = AI_CACHE_LOG2_BUCKET_COUNT;
+    }
+
+    return self;
+}
+
+void AICache_destroy(AICache *self)
+{
+    if (!self) return;
+    QuoridorFileMap_destroy(self->m_map);
+    free(self);
+}
+
+bool AICache_probe(AICache *self, uint64_t key, AICacheData *data)
+{
+    assert(self && "The AICache must be created");
+    const volatile AICacheEntry *bucket = self->m_buckets[key & self->m_indexMask].entries;
+
+    for (int k = 0; k < AI_CACHE_BUCKET_SIZE; k++)
+    {
+        const uint64_t entryKey = bucket[k].key;
+        const uint64_t entryData = bucket[k].data;
+        if ((entryKey ^ entryData) == key && entryData != 0)
+        {
+            AICache_unpack(entryData, data);
+            return true;
+        }
+    }
+    return false;
+}
+
+void AICache_store(AICache *self, uint64_t key, const AICacheData *data)
+{
+    assert(self && "The AICache must be created");
+    volatile AICacheEntry *bucket = self->m_buckets[key & self->m_indexMask].entries;
+
+    // On réutilise l'entrée de la même position ou une entrée vide.
+    // Sinon, on remplace l'analyse la moins profonde du bucket.
+    volatile AICacheEntry *replace = NULL;
+    int replaceDepth = 256;
+
+    for (int k = 0; k < AI_CACHE_BUCKET_SIZE; k++)
+    {
+        volatile AICacheEntry *entry = &bucket[k];
+        const uint64_t entryData = entry->data;
+
+        AICacheData other;
+        AICache_unpack(entryData, &other);
+
+        if ((entry->key ^ entryData) == key && entryData != 0)
+        {
+            if (other.depth > data->depth)
+                return;
+            replace = entry;
+            break;
+        }
+        if (entryData == 0)
+        {
+            replace = entry;
+            break;
+        }
+        if (other.depth < replaceDepth)
+        {
+            replace = entry;
+            replaceDepth = other.depth;
+        }
+    }
+
+    const uint64_t packed = AICache_pack(data);
+    replace->key = key ^ packed;
+    replace->data = packed;
+}
+
+void AICache_flush(AICache *self)
+{
+    assert(self && "The AICache must be created");
+    QuoridorFileMap_flush(self->m_map);
+}
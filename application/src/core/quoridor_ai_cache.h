@@ -0,0 +1,109 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_file_map.h"
+
+// Format du fichier des analyses (projeté en mémoire, petit-boutiste) :
+//   en-tête : "QAC", version, logarithme du nombre de buckets, réservé  (64 octets)
+//   buckets de AI_CACHE_BUCKET_SIZE entrées de 16 octets               (64 octets chacun)
+// Une entrée contient la clé de Zobrist combinée (ou exclusif) avec les données, comme
+// dans la table de transposition : une entrée à moitié écrite est ignorée à la lecture.
+// Un fichier dont l'en-tête ne correspond pas (autre version, autre taille) est vidé.
+
+/// @brief Version du format du fichier des analyses.
+#define AI_CACHE_VERSION 1
+
+/// @brief Nombre d'entrées par bucket du fichier des analyses.
+#define AI_CACHE_BUCKET_SIZE 4
+
+/// @brief Logarithme en base 2 du nombre de buckets (2^16 buckets de 64 octets : 4 Mo).
+#define AI_CACHE_LOG2_BUCKET_COUNT 16
+
+/// @brief Résultat d'une recherche enregistré pour une position.
+typedef struct AICacheData
+{
+    /// @brief Évaluation de la position, du point de vue du joueur qui doit jouer.
+    float score;
+
+    /// @brief Meilleur tour trouvé depuis cette position.
+    QuoridorTurn turn;
+
+    /// @brief Profondeur de la recherche terminée (entre 1 et 255).
+    int depth;
+} AICacheData;
+
+/// @brief Taille de l'en-tête du fichier des analyses, en octets.
+#define AI_CACHE_HEADER_SIZE 64
+
+/// @brief En-tête du fichier des analyses.
+typedef struct AICacheHeader
+{
+    char magic[3];
+    uint8_t version;
+    uint32_t log2BucketCount;
+} AICacheHeader;
+
+/// @brief Entrée (16 octets) du fichier des analyses.
+typedef struct AICacheEntry
+{
+    /// @brief Clé de Zobrist de la position, combinée (ou exclusif) avec le champ data.
+    uint64_t key;
+
+    /// @brief Score, tour et profondeur compactés.
+    uint64_t data;
+} AICacheEntry;
+
+/// @brief Ensemble d'entrées partageant le même indice dans le fichier.
+typedef struct AICacheBucket
+{
+    AICacheEntry entries[AI_CACHE_BUCKET_SIZE];
+} AICacheBucket;
+
+/// @brief Analyses persistantes des positions, partagées entre les parties et les exécutions.
+/// Le fichier est projeté en mémoire : une consultation coûte un accès mémoire et aucun calcul.
+/// Le cache peut être consulté et complété sans verrou par plusieurs threads.
+typedef struct AICache
+{
+    /// @brief Fichier projeté.
+    QuoridorFileMap *m_map;
+
+    /// @brief Buckets du fichier (après l'en-tête).
+    AICacheBucket *m_buckets;
+
+    /// @brief Masque appliqué à la clé pour obtenir l'indice du bucket.
+    uint64_t m_indexMask;
+} AICache;
+
+/// @brief Ouvre (ou crée) le fichier des analyses.
+/// @param path Chemin du fichier.
+/// @return Le cache créé, ou NULL si le fichier ne peut pas être projeté.
+AICache *AICache_create(const char *path);
+
+/// @brief Ferme le fichier des analyses.
+/// @param self Cache (peut être NULL).
+void AICache_destroy(AICache *self);
+
+/// @brief Recherche une position dans le cache.
+/// @param self Cache.
+/// @param key Clé de Zobrist de la position.
+/// @param data Adresse dans laquelle sont écrites les informations trouvées.
+/// @return true si la position est présente, false sinon.
+bool AICache_probe(AICache *self, uint64_t key, AICacheData *data);
+
+/// @brief Enregistre le résultat d'une recherche.
+/// Une analyse plus profonde de la même position est conservée.
+/// @param self Cache.
+/// @param key Clé de Zobrist de la position.
+/// @param data Informations à enregistrer.
+void AICache_store(AICache *self, uint64_t key, const AICacheData *data);
+
+/// @brief Demande l'écriture des analyses dans le fichier, sans attendre leur fin.
+/// @param self Cache.
+void AICache_flush(AICache *self);
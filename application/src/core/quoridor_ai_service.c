@@ -0,0 +1,150 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/quoridor_ai_service.h"
+
+static int AIService_run(void *data)
+{
+    AIService *self = (AIService *)data;
+
+    SDL_LockMutex(self->m_mutex);
+    while (true)
+    {
+        while (!self->m_hasRequest && !self->m_quit)
+            SDL_WaitCondition(self->m_condition, self->m_mutex);
+
+        if (self->m_quit)
+            break;
+
+        // La requête est copiée pour que la recherche se déroule sans le mutex.
+        QuoridorCore core = self->m_core;
+        AISearchParams params = self->m_params;
+        void *aiData = self->m_aiData;
+        const int requestID = self->m_requestID;
+
+        params.stopFlag = &self->m_stopFlag;
+        self->m_hasRequest = false;
+        self->m_busy = true;
+        SDL_UnlockMutex(self->m_mutex);
+
+        QuoridorTurn turn = QuoridorCore_computeTurnWithParams(&core, &params, aiData);
+
+        SDL_LockMutex(self->m_mutex);
+        self->m_busy = false;
+
+        // Le résultat d'une requête annulée ou remplacée est ignoré.
+        if (requestID == self->m_requestID && !SDL_GetAtomicInt(&self->m_stopFlag))
+        {
+            self->m_result = turn;
+            self->m_hasResult = true;
+        }
+        SDL_BroadcastCondition(self->m_condition);
+    }
+    SDL_UnlockMutex(self->m_mutex);
+
+    return 0;
+}
+
+AIService *AIService_create()
+{
+    AIService *self = (AIService *)calloc(1, sizeof(AIService));
+    AssertNew(self);
+
+    self->m_mutex = SDL_CreateMutex();
+    AssertNew(self->m_mutex);
+
+    self->m_condition = SDL_CreateCondition();
+    AssertNew(self->m_condition);
+
+    SDL_SetAtomicInt(&self->m_stopFlag, 0);
+
+    self->m_thread = SDL_CreateThread(AIService_run, "AIService", self);
+    AssertNew(self->m_thread);
+
+    return self;
+}
+
+void AIService_destroy(AIService *self)
+{
+    if (!self) return;
+
+    SDL_LockMutex(self->m_mutex);
+    self->m_quit = true;
+    SDL_SetAtomicInt(&self->m_stopFlag, 1);
+    SDL_BroadcastCondition(self->m_condition);
+    SDL_UnlockMutex(self->m_mutex);
+
+    SDL_WaitThread(self->m_thread, NULL);
+
+    SDL_DestroyCondition(self->m_condition);
+    SDL_DestroyMutex(self->m_mutex);
+    free(self);
+}
+
+/// @brief Annule la requête courante. Le mutex doit être verrouillé.
+static void AIService_cancelLocked(AIService *self)
+{
+    self->m_requestID++;
+    self->m_hasRequest = false;
+    self->m_hasResult = false;
+
+    SDL_SetAtomicInt(&self->m_stopFlag, 1);
+    while (self->m_busy)
+        SDL_WaitCondition(self->m_condition, self->m_mutex);
+    SDL_SetAtomicInt(&self->m_stopFlag, 0);
+}
+
+void AIService_request(AIService *self, QuoridorCore *core, const AISearchParams *params, void *aiData)
+{
+    assert(self && "The AIService must be created");
+
+    SDL_LockMutex(self->m_mutex);
+    AIService_cancelLocked(self);
+
+    self->m_core = *core;
+    self->m_params = *params;
+    self->m_aiData = aiData;
+    self->m_hasRequest = true;
+
+    SDL_BroadcastCondition(self->m_condition);
+    SDL_UnlockMutex(self->m_mutex);
+}
+
+bool AIService_poll(AIService *self, QuoridorTurn *turn)
+{
+    assert(self && "The AIService must be created");
+
+    SDL_LockMutex(self->m_mutex);
+    const bool hasResult = self->m_hasResult;
+    if (hasResult)
+    {
+        *turn = self->m_result;
+        self->m_hasResult = false;
+    }
+    SDL_UnlockMutex(self->m_mutex);
+
+    return hasResult;
+}
+
+void AIService_cancel(AIService *self)
+{
+    assert(self && "The AIService must be created");
+
+    SDL_LockMutex(self->m_mutex);
+    AIService_cancelLocked(self);
+    SDL_UnlockMutex(self->m_mutex);
+}
+
+bool AIService_isBusy(AIService *self)
+{
+    assert(self && "The AIService must be created");
+
+    SDL_LockMutex(self->m_mutex);
+    const bool isBusy = self->m_hasRequest || self->m_busy;
+    SDL_UnlockMutex(self->m_mutex);
+
+    return isBusy;
+}
@@ -0,0 +1,94 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_ai.h"
+
+/// @brief Service exécutant les recherches de l'IA sur un thread dédié.
+/// Une requête contient une copie du plateau : la partie peut continuer à être affichée
+/// pendant la recherche. Le résultat est déposé dans une boîte aux lettres que l'appelant
+/// consulte à chaque frame avec AIService_poll().
+typedef struct AIService
+{
+    /// @brief Thread exécutant les recherches.
+    SDL_Thread *m_thread;
+
+    /// @brief Mutex protégeant la requête, le résultat et l'état du service.
+    SDL_Mutex *m_mutex;
+
+    /// @brief Condition signalée à chaque nouvelle requête et à chaque fin de recherche.
+    SDL_Condition *m_condition;
+
+    /// @brief Drapeau d'arrêt transmis à la recherche en cours.
+    SDL_AtomicInt m_stopFlag;
+
+    /// @brief Copie du plateau sur lequel porte la requête.
+    QuoridorCore m_core;
+
+    /// @brief Paramètres de la recherche demandée.
+    AISearchParams m_params;
+
+    /// @brief Données de l'IA utilisées par la recherche demandée.
+    void *m_aiData;
+
+    /// @brief Identifiant de la dernière requête.
+    /// Un résultat n'est publié que s'il correspond à la dernière requête.
+    int m_requestID;
+
+    /// @brief Indique si une requête attend d'être traitée.
+    bool m_hasRequest;
+
+    /// @brief Indique si une recherche est en cours.
+    bool m_busy;
+
+    /// @brief Indique si un résultat est disponible.
+    bool m_hasResult;
+
+    /// @brief Tour calculé par la dernière recherche terminée.
+    QuoridorTurn m_result;
+
+    /// @brief Indique que le thread doit se terminer.
+    bool m_quit;
+} AIService;
+
+/// @brief Crée le service et démarre son thread.
+/// @return Un pointeur vers le service créé.
+AIService *AIService_create();
+
+/// @brief Interrompt la recherche en cours, arrête le thread et détruit le service.
+/// @param self Service à détruire.
+void AIService_destroy(AIService *self);
+
+/// @brief Demande au service de calculer le coup du joueur courant.
+/// La recherche en cours éventuelle est d'abord annulée.
+/// Les données de l'IA ne doivent pas être utilisées par l'appelant avant la fin de la recherche
+/// (résultat reçu avec AIService_poll() ou appel à AIService_cancel()).
+/// @param self Service.
+/// @param core Plateau à analyser (copié).
+/// @param params Paramètres de la recherche (le drapeau d'arrêt est fourni par le service).
+/// @param aiData Données de l'IA du joueur courant.
+void AIService_request(AIService *self, QuoridorCore *core, const AISearchParams *params, void *aiData);
+
+/// @brief Récupère le résultat de la dernière requête s'il est disponible.
+/// Cette fonction ne bloque pas.
+/// @param self Service.
+/// @param turn Adresse dans laquelle est écrit le tour calculé.
+/// @return true si un résultat a été récupéré, false sinon.
+bool AIService_poll(AIService *self, QuoridorTurn *turn);
+
+/// @brief Annule la requête en attente et interrompt la recherche en cours.
+/// La fonction attend la fin effective de la recherche : les données de l'IA
+/// peuvent ensuite être modifiées sans risque.
+/// @param self Service.
+void AIService_cancel(AIService *self);
+
+/// @brief Indique si une requête est en attente ou en cours de traitement.
+/// @param self Service.
+/// @return true si le service calcule un coup, false sinon.
+bool AIService_isBusy(AIService *self);
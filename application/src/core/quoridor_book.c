@@ -0,0 +1,139 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/quoridor_book.h"
+#include <limits.h>
+
+QuoridorBook *QuoridorBook_create(const char *path)
+{
+    QuoridorFileMap *map = QuoridorFileMap_create(path, 0, false);
+    if (map == NULL) return NULL;
+
+    const QuoridorBookHeader *header = (const QuoridorBookHeader *)map->data;
+    const bool valid = map->size >= QUORIDOR_BOOK_HEADER_SIZE
+        && memcmp(header->magic, "QOB", 3) == 0 && header->version == QUORIDOR_BOOK_VERSION
+        && header->entryCount <= INT_MAX
+        && map->size >= QUORIDOR_BOOK_HEADER_SIZE + (size_t)header->entryCount * sizeof(QuoridorBookEntry);
+    if (!valid)
+    {
+        QuoridorFileMap_destroy(map);
+        return NULL;
+    }
+
+    QuoridorBook *self = (QuoridorBook *)calloc(1, sizeof(QuoridorBook));
+    AssertNew(self);
+
+    self->m_map = map;
+    self->m_entries = (const QuoridorBookEntry *)((const uint8_t *)map->data + QUORIDOR_BOOK_HEADER_SIZE);
+    self->m_entryCount = (int)header->entryCount;
+
+    return self;
+}
+
+void QuoridorBook_destroy(QuoridorBook *self)
+{
+    if (!self) return;
+    QuoridorFileMap_destroy(self->m_map);
+    free(self);
+}
+
+bool QuoridorBook_probe(const QuoridorBook *self, QuoridorCore *core, uint64_t random, QuoridorTurn *turn)
+{
+    assert(self && "The QuoridorBook must be created");
+    const uint64_t key = core->hashKey;
+
+    // Première entrée de la position (recherche dichotomique).
+    int first = 0;
+    int last = self->m_entryCount;
+    while (first < last)
+    {
+        const int middle = first + (last - first) / 2;
+        if (self->m_entries[middle].key < key)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    // Seuls les tours légaux sont tirés : une collision de clés ne donne jamais de tour illégal.
+    uint64_t totalWeight = 0;
+    for (int k = first; k < self->m_entryCount && self->m_entries[k].key == key; k++)
+    {
+        if (QuoridorCore_canPlayTurn(core, QuoridorBook_decodeTurn(self->m_entries[k].turn)))
+            totalWeight += self->m_entries[k].weight;
+    }
+    if (totalWeight == 0)
+        return false;
+
+    uint64_t choice = random % totalWeight;
+
+    for (int k = first; k < self->m_entryCount && self->m_entries[k].key == key; k++)
+    {
+        const QuoridorTurn bookTurn = QuoridorBook_decodeTurn(self->m_entries[k].turn);
+        if (!QuoridorCore_canPlayTurn(core, bookTurn))
+            continue;
+
+        if (choice < self->m_entries[k].weight)
+        {
+            *turn = bookTurn;
+            return true;
+        }
+        choice -= self->m_entries[k].weight;
+    }
+    return false;
+}
+
+static int QuoridorBookEntry_compare(const void *a, const void *b)
+{
+    const QuoridorBookEntry *entryA = (const QuoridorBookEntry *)a;
+    const QuoridorBookEntry *entryB = (const QuoridorBookEntry *)b;
+    if (entryA->key != entryB->key)
+        return (entryA->key < entryB->key) ? -1 : 1;
+    return (int)entryA->turn - (int)entryB->turn;
+}
+
+int QuoridorBook_merge(QuoridorBookEntry *entries, int entryCount)
+{
+    qsort(entries, entryCount, sizeof(QuoridorBookEntry), QuoridorBookEntry_compare);
+
+    int count = 0;
+    for (int k = 0; k < entryCount; k++)
+    {
+        if (entries[k].weight == 0)
+            continue;
+
+        if (count > 0 && entries[count - 1].key == entries[k].key && entries[count - 1].turn == entries[k].turn)
+        {
+            const uint64_t weight = (uint64_t)entries[count - 1].weight + entries[k].weight;
+            entries[count - 1].weight = (weight > UINT32_MAX) ? UINT32_MAX : (uint32_t)weight;
+        }
+        else
+        {
+            entries[count] = entries[k];
+            entries[count].reserved = 0;
+            count++;
+        }
+    }
+    return count;
+}
+
+int QuoridorBook_write(const char *path, QuoridorBookEntry *entries, int entryCount)
+{
+    const int count = QuoridorBook_merge(entries, entryCount);
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return -1;
+
+    QuoridorBookHeader header = { 0 };
+    memcpy(header.magic, "QOB", 3);
+    header.version = QUORIDOR_BOOK_VERSION;
+    header.entryCount = (uint32_t)count;
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    written = written && (count == 0 || fwrite(entries, sizeof(QuoridorBookEntry), count, file) == (size_t)count);
+    written = (fclose(file) == 0) && written;
+
+    return written ? count : -1;
+}
@@ -0,0 +1,110 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_file_map.h"
+
+// Format du livre d'ouvertures (projeté en mémoire en lecture seule, petit-boutiste) :
+//   en-tête : "QOB", version, nombre d'entrées, réservé                      (16 octets)
+//   entrées triées par clé de Zobrist puis par tour                          (16 octets chacune)
+// Une position possède une entrée par tour connu ; son poids est proportionnel
+// à la probabilité que le tour soit choisi. Le livre est créé par l'outil quoridor_book.
+
+/// @brief Version du format du livre d'ouvertures.
+#define QUORIDOR_BOOK_VERSION 1
+
+/// @brief Taille de l'en-tête du livre d'ouvertures, en octets.
+#define QUORIDOR_BOOK_HEADER_SIZE 16
+
+/// @brief En-tête du livre d'ouvertures.
+typedef struct QuoridorBookHeader
+{
+    char magic[3];
+    uint8_t version;
+    uint32_t entryCount;
+    uint64_t reserved;
+} QuoridorBookHeader;
+
+/// @brief Tour du livre pour une position.
+typedef struct QuoridorBookEntry
+{
+    /// @brief Clé de Zobrist de la position.
+    uint64_t key;
+
+    /// @brief Poids du tour (strictement positif).
+    uint32_t weight;
+
+    /// @brief Tour codé par QuoridorBook_encodeTurn().
+    uint16_t turn;
+
+    uint16_t reserved;
+} QuoridorBookEntry;
+
+/// @brief Livre d'ouvertures projeté en mémoire.
+/// La consultation ne fait aucune allocation : une recherche dichotomique dans le fichier.
+typedef struct QuoridorBook
+{
+    /// @brief Fichier projeté (lecture seule).
+    QuoridorFileMap *m_map;
+
+    /// @brief Entrées du livre (après l'en-tête).
+    const QuoridorBookEntry *m_entries;
+    int m_entryCount;
+} QuoridorBook;
+
+/// @brief Code un tour sur 16 bits (action, ligne, colonne).
+INLINE uint16_t QuoridorBook_encodeTurn(QuoridorTurn turn)
+{
+    return (uint16_t)(((turn.action & 3) << 8) | ((turn.i & 15) << 4) | (turn.j & 15));
+}
+
+/// @brief Décode un tour codé par QuoridorBook_encodeTurn().
+INLINE QuoridorTurn QuoridorBook_decodeTurn(uint16_t code)
+{
+    QuoridorTurn turn = { 0 };
+    turn.action = (QuoridorAction)((code >> 8) & 3);
+    turn.i = (code >> 4) & 15;
+    turn.j = code & 15;
+    return turn;
+}
+
+/// @brief Ouvre un livre d'ouvertures en lecture seule.
+/// @param path Chemin du fichier.
+/// @return Le livre, ou NULL si le fichier n'existe pas ou n'est pas un livre valide.
+QuoridorBook *QuoridorBook_create(const char *path);
+
+/// @brief Ferme un livre d'ouvertures.
+/// @param self Livre (peut être NULL).
+void QuoridorBook_destroy(QuoridorBook *self);
+
+/// @brief Choisit un tour du livre pour la position courante.
+/// Le tour est tiré parmi les tours légaux de la position, selon leurs poids.
+/// Le tirage ne dépend que de la valeur aléatoire donnée : la fonction n'utilise pas rand()
+/// et peut être appelée depuis plusieurs threads.
+/// @param self Livre.
+/// @param core Position.
+/// @param random Valeur pseudo-aléatoire uniforme sur 64 bits, fournie par l'appelant.
+/// @param turn Adresse dans laquelle est écrit le tour choisi.
+/// @return true si la position figure dans le livre, false sinon.
+bool QuoridorBook_probe(const QuoridorBook *self, QuoridorCore *core, uint64_t random, QuoridorTurn *turn);
+
+/// @brief Trie les entrées d'un livre et fusionne celles d'un même tour dans une même position
+/// (somme des poids). Les entrées de poids nul sont retirées.
+/// @param entries Entrées du livre (modifiées).
+/// @param entryCount Nombre d'entrées.
+/// @return Le nombre d'entrées restantes.
+int QuoridorBook_merge(QuoridorBookEntry *entries, int entryCount);
+
+/// @brief Écrit un livre d'ouvertures.
+/// Les entrées sont d'abord triées et fusionnées avec QuoridorBook_merge() ; le tableau est modifié.
+/// @param path Chemin du fichier.
+/// @param entries Entrées du livre.
+/// @param entryCount Nombre d'entrées.
+/// @return Le nombre d'entrées écrites, ou -1 si le fichier ne peut pas être écrit.
+int QuoridorBook_write(const char *path, QuoridorBookEntry *entries, int entryCount);
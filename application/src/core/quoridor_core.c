@@ -6,10 +6,246 @@
 
 #include "core/quoridor_core.h"
 #include "core/quoridor_ai.h"
+#include "core/utils.h"
 
-void QuoridorCore_updateValidMoves(QuoridorCore *self);
 bool QuoridorCore_isFeasible(QuoridorCore *self);
 
+// Indices des clés de Zobrist
+#define ZOBRIST_H_WALL 0
+#define ZOBRIST_V_WALL 128
+#define ZOBRIST_PAWN 256
+#define ZOBRIST_SIDE 512
+#define ZOBRIST_WALL_COUNT 520
+#define ZOBRIST_GRID_SIZE 600
+
+/// @brief Renvoie la clé de Zobrist d'indice donné.
+/// Les clés sont obtenues par une fonction de hachage (splitmix64) plutôt que stockées dans une table :
+/// elles sont identiques d'une exécution à l'autre et ne nécessitent aucune initialisation.
+/// @param index Indice de la clé.
+/// @return La clé pseudo-aléatoire sur 64 bits.
+static uint64_t QuoridorCore_getZobristKey(int index)
+{
+    uint64_t z = 0x5155524944524F52ULL + (uint64_t)(index + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t QuoridorCore_getPawnKey(int playerID, QuoridorPos pos)
+{
+    return QuoridorCore_getZobristKey(ZOBRIST_PAWN + playerID * 128 + pos.i * MAX_GRID_SIZE + pos.j);
+}
+
+static uint64_t QuoridorCore_getWallCountKey(int playerID, int wallCount)
+{
+    return QuoridorCore_getZobristKey(ZOBRIST_WALL_COUNT + playerID * 32 + (wallCount & 31));
+}
+
+uint64_t QuoridorCore_computeHash(QuoridorCore *self)
+{
+    uint64_t hashKey = QuoridorCore_getZobristKey(ZOBRIST_GRID_SIZE + self->gridSize);
+
+    QuoridorMask walls = self->hWalls;
+    while (!QuoridorMask_isZero(walls))
+        hashKey ^= QuoridorCore_getZobristKey(ZOBRIST_H_WALL + QuoridorMask_popLSB(&walls));
+
+    walls = self->vWalls;
+    while (!QuoridorMask_isZero(walls))
+        hashKey ^= QuoridorCore_getZobristKey(ZOBRIST_V_WALL + QuoridorMask_popLSB(&walls));
+
+    for (int playerID = 0; playerID < 2; playerID++)
+    {
+        hashKey ^= QuoridorCore_getPawnKey(playerID, self->positions[playerID]);
+        hashKey ^= QuoridorCore_getWallCountKey(playerID, self->wallCounts[playerID]);
+    }
+
+    if (self->playerID) hashKey ^= QuoridorCore_getZobristKey(ZOBRIST_SIDE);
+
+    return hashKey;
+}
+
+/// @brief Renvoie les cases voisines d'une case accessibles sans franchir de mur.
+/// @param self Instance du jeu Quoridor.
+/// @param k Indice de la case (i * MAX_GRID_SIZE + j).
+/// @param neighbors Tableau (de taille 4) dans lequel sont écrits les indices des cases voisines.
+/// @return Le nombre de cases voisines.
+static int QuoridorCore_getNeighbors(QuoridorCore *self, int k, int neighbors[4])
+{
+    const int i = k / MAX_GRID_SIZE;
+    const int j = k % MAX_GRID_SIZE;
+    int count = 0;
+
+    if (!QuoridorCore_hasWallAbove(self, i, j)) neighbors[count++] = k - MAX_GRID_SIZE;
+    if (!QuoridorCore_hasWallBelow(self, i, j)) neighbors[count++] = k + MAX_GRID_SIZE;
+    if (!QuoridorCore_hasWallLeft(self, i, j)) neighbors[count++] = k - 1;
+    if (!QuoridorCore_hasWallRight(self, i, j)) neighbors[count++] = k + 1;
+
+    return count;
+}
+
+/// @brief Calcule entièrement le champ de distances d'un joueur.
+/// Parcours en largeur dont les sources sont toutes les cases de la zone d'arrivée.
+static void QuoridorCore_computeDistances(QuoridorCore *self, int playerID)
+{
+    const int gridSize = self->gridSize;
+    const int targetJ = (playerID == 0) ? gridSize - 1 : 0;
+    uint8_t *distances = self->distances[playerID];
+
+    int queue[MAX_GRID_SIZE * MAX_GRID_SIZE];
+    int readCursor = 0;
+    int writeCursor = 0;
+
+    memset(distances, QUORIDOR_DISTANCE_INFINITE, sizeof(self->distances[playerID]));
+    for (int i = 0; i < gridSize; i++)
+    {
+        const int k = i * MAX_GRID_SIZE + targetJ;
+        distances[k] = 0;
+        queue[writeCursor++] = k;
+    }
+
+    while (readCursor < writeCursor)
+    {
+        const int k = queue[readCursor++];
+        int neighbors[4];
+        const int count = QuoridorCore_getNeighbors(self, k, neighbors);
+        for (int n = 0; n < count; n++)
+        {
+            const int next = neighbors[n];
+            if (distances[next] != QUORIDOR_DISTANCE_INFINITE) continue;
+
+            distances[next] = distances[k] + 1;
+            queue[writeCursor++] = next;
+        }
+    }
+}
+
+/// @brief Met à jour le champ de distances d'un joueur après la pose d'un mur.
+/// Un mur ne peut qu'allonger les distances. Seules les cases dont tous les plus courts chemins
+/// empruntaient l'un des deux passages coupés par le mur sont recalculées.
+/// @param self Instance du jeu Quoridor (le mur est déjà posé).
+/// @param playerID Identifiant du joueur.
+/// @param cutEdges Les deux passages coupés par le mur (paires d'indices de cases).
+static void QuoridorCore_updateDistances(QuoridorCore *self, int playerID, const int cutEdges[2][2])
+{
+    uint8_t *distances = self->distances[playerID];
+
+    // 1. Recherche des cases touchées, par distance croissante.
+    // Une case reste valide si elle possède une voisine valide plus proche de l'arrivée.
+    // Sinon elle est touchée et ses voisines plus éloignées deviennent candidates.
+    int bucketHeads[MAX_PATH_LEN];
+    int bucketNext[MAX_GRID_SIZE * MAX_GRID_SIZE];
+    bool queued[MAX_GRID_SIZE * MAX_GRID_SIZE] = { 0 };
+    bool affected[MAX_GRID_SIZE * MAX_GRID_SIZE] = { 0 };
+    int affectedCells[MAX_GRID_SIZE * MAX_GRID_SIZE];
+    int affectedCount = 0;
+    int minBucket = MAX_PATH_LEN;
+    int maxBucket = -1;
+
+    for (int d = 0; d < MAX_PATH_LEN; d++)
+        bucketHeads[d] = -1;
+
+    for (int e = 0; e < 2; e++)
+    {
+        const int a = cutEdges[e][0];
+        const int b = cutEdges[e][1];
+        int candidate = -1;
+        if (distances[a] != QUORIDOR_DISTANCE_INFINITE && distances[a] == distances[b] + 1) candidate = a;
+        else if (distances[b] != QUORIDOR_DISTANCE_INFINITE && distances[b] == distances[a] + 1) candidate = b;
+
+        if (candidate < 0 || queued[candidate]) continue;
+
+        const int d = distances[candidate];
+        queued[candidate] = true;
+        bucketNext[candidate] = bucketHeads[d];
+        bucketHeads[d] = candidate;
+        minBucket = Int_min(minBucket, d);
+        maxBucket = Int_max(maxBucket, d);
+    }
+
+    for (int d = minBucket; d <= maxBucket; d++)
+    {
+        while (bucketHeads[d] >= 0)
+        {
+            const int k = bucketHeads[d];
+            bucketHeads[d] = bucketNext[k];
+
+            int neighbors[4];
+            const int count = QuoridorCore_getNeighbors(self, k, neighbors);
+
+            bool supported = false;
+            for (int n = 0; n < count && !supported; n++)
+            {
+                const int next = neighbors[n];
+                supported = (distances[next] + 1 == d) && !affected[next];
+            }
+            if (supported) continue;
+
+            affected[k] = true;
+            affectedCells[affectedCount++] = k;
+
+            for (int n = 0; n < count; n++)
+            {
+                const int next = neighbors[n];
+                if (distances[next] != d + 1 || queued[next]) continue;
+
+                queued[next] = true;
+                bucketNext[next] = bucketHeads[d + 1];
+                bucketHeads[d + 1] = next;
+                maxBucket = Int_max(maxBucket, d + 1);
+            }
+        }
+    }
+
+    if (affectedCount == 0)
+        return;
+
+    // 2. Nouvelles distances des cases touchées (algorithme de Dijkstra restreint à ces cases),
+    // initialisées à partir de leurs voisines non touchées.
+    for (int a = 0; a < affectedCount; a++)
+    {
+        const int k = affectedCells[a];
+        int neighbors[4];
+        const int count = QuoridorCore_getNeighbors(self, k, neighbors);
+
+        int best = QUORIDOR_DISTANCE_INFINITE;
+        for (int n = 0; n < count; n++)
+        {
+            const int next = neighbors[n];
+            if (!affected[next] && distances[next] != QUORIDOR_DISTANCE_INFINITE)
+                best = Int_min(best, distances[next] + 1);
+        }
+        distances[k] = (uint8_t)best;
+    }
+
+    int remaining = affectedCount;
+    while (remaining > 0)
+    {
+        int bestIndex = 0;
+        for (int a = 1; a < remaining; a++)
+        {
+            if (distances[affectedCells[a]] < distances[affectedCells[bestIndex]])
+                bestIndex = a;
+        }
+
+        const int k = affectedCells[bestIndex];
+        affectedCells[bestIndex] = affectedCells[--remaining];
+        affected[k] = false;
+
+        if (distances[k] == QUORIDOR_DISTANCE_INFINITE)
+            break;
+
+        int neighbors[4];
+        const int count = QuoridorCore_getNeighbors(self, k, neighbors);
+        for (int n = 0; n < count; n++)
+        {
+            const int next = neighbors[n];
+            if (affected[next] && distances[k] + 1 < distances[next])
+                distances[next] = distances[k] + 1;
+        }
+    }
+
+}
+
 QuoridorCore *QuoridorCore_create()
 {
     QuoridorCore *self = (QuoridorCore *)calloc(1, sizeof(QuoridorCore));
@@ -17,11 +253,6 @@ QuoridorCore *QuoridorCore_create()
 
     QuoridorCore_reset(self, 9, 10, 0);
 
-	// On initialise le fichier de sauvegarde
-    FILE* file = fopen(FILE_TO_SAVE_GAME, "r+");
-    fprintf(file, "0\n");
-    fclose(file);
-
     return self;
 }
 
@@ -46,13 +277,22 @@ void QuoridorCore_reset(QuoridorCore *self, int gridSize, int wallCount, int fir
     self->wallCounts[0] = wallCount;
     self->wallCounts[1] = wallCount;
 
+    self->hashKey = QuoridorCore_computeHash(self);
+
+    QuoridorCore_computeDistances(self, 0);
+    QuoridorCore_computeDistances(self, 1);
+
     QuoridorCore_updateValidMoves(self);
 }
 
 void QuoridorCore_randomStart(QuoridorCore *self)
 {
-    self->wallCounts[0] += 2;
-    self->wallCounts[1] += 2;
+    for (int playerID = 0; playerID < 2; playerID++)
+    {
+        self->hashKey ^= QuoridorCore_getWallCountKey(playerID, self->wallCounts[playerID]);
+        self->wallCounts[playerID] += 2;
+        self->hashKey ^= QuoridorCore_getWallCountKey(playerID, self->wallCounts[playerID]);
+    }
 
     const int gridSize = self->gridSize;
 
@@ -72,43 +312,58 @@ void QuoridorCore_randomStart(QuoridorCore *self)
     }
 }
 
+bool QuoridorCore_playStartWalls(QuoridorCore *self, const QuoridorTurn *walls, int wallCount)
+{
+    const int firstPlayer = self->playerID;
+    for (int playerID = 0; playerID < 2; playerID++)
+    {
+        const int extraCount = (playerID == firstPlayer) ? (wallCount + 1) / 2 : wallCount / 2;
+        self->hashKey ^= QuoridorCore_getWallCountKey(playerID, self->wallCounts[playerID]);
+        self->wallCounts[playerID] += extraCount;
+        self->hashKey ^= QuoridorCore_getWallCountKey(playerID, self->wallCounts[playerID]);
+    }
+
+    for (int w = 0; w < wallCount; w++)
+    {
+        const QuoridorTurn turn = walls[w];
+        if (turn.action == QUORIDOR_MOVE_TO || !QuoridorCore_canPlayTurn(self, turn))
+            return false;
+
+        QuoridorCore_playTurn(self, turn);
+    }
+    return true;
+}
+
 bool QuoridorCore_canPlayWall(QuoridorCore *self, WallType type, int i, int j)
 {
     if (i < 0 || i >= self->gridSize - 1) return false;
     if (j < 0 || j >= self->gridSize - 1) return false;
     if (self->wallCounts[self->playerID] <= 0) return false;
 
+    const int k = i * MAX_GRID_SIZE + j;
     bool isFeasible;
 
     switch (type)
     {
     case WALL_TYPE_HORIZONTAL:
-        if (self->hWalls[i][j] != WALL_STATE_NONE) return false;
-        if (self->hWalls[i][j + 1] != WALL_STATE_NONE) return false;
-        if (self->vWalls[i][j] == WALL_STATE_START) return false;
-
-        self->hWalls[i][j] = WALL_STATE_START;
-        self->hWalls[i][j + 1] = WALL_STATE_END;
+        if (QuoridorCore_hasWallBelow(self, i, j)) return false;
+        if (QuoridorCore_hasWallBelow(self, i, j + 1)) return false;
+        if (QuoridorMask_test(self->vWalls, k)) return false;
 
+        QuoridorMask_set(&self->hWalls, k);
         isFeasible = QuoridorCore_isFeasible(self);
-
-        self->hWalls[i][j] = WALL_STATE_NONE;
-        self->hWalls[i][j + 1] = WALL_STATE_NONE;
+        QuoridorMask_reset(&self->hWalls, k);
 
         return isFeasible;
         break;
     default:
-        if (self->vWalls[i][j] != WALL_STATE_NONE) return false;
-        if (self->vWalls[i + 1][j] != WALL_STATE_NONE) return false;
-        if (self->hWalls[i][j] == WALL_STATE_START) return false;
-
-        self->vWalls[i][j] = WALL_STATE_START;
-        self->vWalls[i + 1][j] = WALL_STATE_END;
+        if (QuoridorCore_hasWallRight(self, i, j)) return false;
+        if (QuoridorCore_hasWallRight(self, i + 1, j)) return false;
+        if (QuoridorMask_test(self->hWalls, k)) return false;
 
+        QuoridorMask_set(&self->vWalls, k);
         isFeasible = QuoridorCore_isFeasible(self);
-
-        self->vWalls[i][j] = WALL_STATE_NONE;
-        self->vWalls[i+1][j] = WALL_STATE_NONE;
+        QuoridorMask_reset(&self->vWalls, k);
 
         return isFeasible;
         break;
@@ -117,25 +372,21 @@ bool QuoridorCore_canPlayWall(QuoridorCore *self, WallType type, int i, int j)
 
 void QuoridorCore_updateValidMoves(QuoridorCore *self)
 {
-    const int gridSize = self->gridSize;
     const int currI = self->positions[self->playerID].i;
     const int currJ = self->positions[self->playerID].j;
     const int otherI = self->positions[self->playerID ^ 1].i;
     const int otherJ = self->positions[self->playerID ^ 1].j;
 
-    // TODO
-
-    // Par exemple :
-    memset(self->isValid, 0, sizeof(self->isValid));
+    self->validMoves = 0;
 
     if (!QuoridorCore_hasWallAbove(self, currI, currJ))
-        self->isValid[currI - 1][currJ] = true;
+        QuoridorCore_setValidPosition(self, currI - 1, currJ, true);
     if (!QuoridorCore_hasWallBelow(self, currI, currJ))
-        self->isValid[currI + 1][currJ] = true;
+        QuoridorCore_setValidPosition(self, currI + 1, currJ, true);
     if (!QuoridorCore_hasWallLeft(self, currI, currJ))
-        self->isValid[currI][currJ - 1] = true;
+        QuoridorCore_setValidPosition(self, currI, currJ - 1, true);
     if (!QuoridorCore_hasWallRight(self, currI, currJ))
-        self->isValid[currI][currJ + 1] = true;
+        QuoridorCore_setValidPosition(self, currI, currJ + 1, true);
 
     // Cas de contact other au dessus
     if (currI - 1 == otherI && currJ == otherJ && !QuoridorCore_hasWallAbove(self, currI, currJ))
@@ -143,9 +394,9 @@ void QuoridorCore_updateValidMoves(QuoridorCore *self)
         if (QuoridorCore_hasWallAbove(self, otherI, otherJ))
         {
             if (!QuoridorCore_hasWallLeft(self, otherI, otherJ))
-                self->isValid[otherI][otherJ - 1] = true;
+                QuoridorCore_setValidPosition(self, otherI, otherJ - 1, true);
             if (!QuoridorCore_hasWallRight(self, otherI, otherJ))
-                self->isValid[otherI][otherJ + 1] = true;
+                QuoridorCore_setValidPosition(self, otherI, otherJ + 1, true);
         }
         else
             QuoridorCore_setValidPosition(self, otherI - 1,otherJ, true);
@@ -156,9 +407,9 @@ void QuoridorCore_updateValidMoves(QuoridorCore *self)
         if (QuoridorCore_hasWallBelow(self, otherI, otherJ))
         {
             if (!QuoridorCore_hasWallLeft(self, otherI, otherJ))
-                self->isValid[otherI][otherJ - 1] = true;
+                QuoridorCore_setValidPosition(self, otherI, otherJ - 1, true);
             if (!QuoridorCore_hasWallRight(self, otherI, otherJ))
-                self->isValid[otherI][otherJ + 1] = true;
+                QuoridorCore_setValidPosition(self, otherI, otherJ + 1, true);
         }
         else
             QuoridorCore_setValidPosition(self, otherI + 1, otherJ, true);
@@ -169,9 +420,9 @@ void QuoridorCore_updateValidMoves(QuoridorCore *self)
         if (QuoridorCore_hasWallLeft(self, otherI, otherJ))
         {
             if (!QuoridorCore_hasWallAbove(self, otherI, otherJ))
-                self->isValid[otherI - 1][otherJ] = true;
+                QuoridorCore_setValidPosition(self, otherI - 1, otherJ, true);
             if (!QuoridorCore_hasWallBelow(self, otherI, otherJ))
-                self->isValid[otherI + 1][otherJ] = true;
+                QuoridorCore_setValidPosition(self, otherI + 1, otherJ, true);
         }
         else
             QuoridorCore_setValidPosition(self, otherI, otherJ - 1, true);
@@ -182,77 +433,261 @@ void QuoridorCore_updateValidMoves(QuoridorCore *self)
         if (QuoridorCore_hasWallRight(self, otherI, otherJ))
         {
             if (!QuoridorCore_hasWallAbove(self, otherI, otherJ))
-                self->isValid[otherI - 1][otherJ] = true;
+                QuoridorCore_setValidPosition(self, otherI - 1, otherJ, true);
             if (!QuoridorCore_hasWallBelow(self, otherI, otherJ))
-                self->isValid[otherI + 1][otherJ] = true;
+                QuoridorCore_setValidPosition(self, otherI + 1, otherJ, true);
         }
         else
             QuoridorCore_setValidPosition(self, otherI, otherJ + 1, true);
     }
 
-    self->isValid[currI][currJ] = false;
-    self->isValid[otherI][otherJ] = false;
+    QuoridorCore_setValidPosition(self, otherI, otherJ, false);
 }
 
-static bool QuoridorCore_isFeasibleRec0(QuoridorCore *self, bool explored[MAX_GRID_SIZE][MAX_GRID_SIZE], int i, int j)
+/// @brief Masques décrivant les déplacements possibles sur le plateau, sans tenir compte des pions.
+typedef struct QuoridorMoveMasks
+{
+    /// @brief Cases dont on peut descendre (pas de mur, pas la dernière ligne).
+    QuoridorMask canDown;
+
+    /// @brief Cases dont on peut aller à droite (pas de mur, pas la dernière colonne).
+    QuoridorMask canRight;
+
+    /// @brief Cases d'arrivée de chaque joueur.
+    QuoridorMask goals[2];
+
+    /// @brief Emplacements où un mur peut commencer (ni la dernière ligne, ni la dernière colonne).
+    QuoridorMask wallSlots;
+} QuoridorMoveMasks;
+
+static void QuoridorCore_getMoveMasks(QuoridorCore *self, QuoridorMoveMasks *masks)
 {
     const int gridSize = self->gridSize;
-    if (j >= gridSize - 1) return true;
 
-    // TODO
-    // Fonction récursive vérifiant qu'il existe un chemin permettant au joueur 0 de terminer la partie.
-    // Cette fonction réalise un parcours en profondeur.
-    // Ordonnez les cases voisines à explorer pour améliorer les performances.
-    explored[i][j] = true;
+    // Un mur horizontal en (i,j) bloque la descente depuis (i,j) et (i,j+1).
+    // Un mur vertical en (i,j) bloque le passage vers la droite depuis (i,j) et (i+1,j).
+    QuoridorMask blockedDown = QuoridorMask_or(self->hWalls, QuoridorMask_shl(self->hWalls, 1));
+    QuoridorMask blockedRight = QuoridorMask_or(self->vWalls, QuoridorMask_shl(self->vWalls, MAX_GRID_SIZE));
 
-    if (!explored[i][j + 1] && !QuoridorCore_hasWallRight(self, i, j) && QuoridorCore_isFeasibleRec0(self, explored, i, j + 1)) return true;
-    if (!explored[i - 1][j] && !QuoridorCore_hasWallAbove(self, i, j) && QuoridorCore_isFeasibleRec0(self, explored, i - 1, j)) return true;
-    if (!explored[i + 1][j] && !QuoridorCore_hasWallBelow(self, i, j) && QuoridorCore_isFeasibleRec0(self, explored, i + 1, j)) return true;
-    if (!explored[i][j - 1] && !QuoridorCore_hasWallLeft(self, i, j) && QuoridorCore_isFeasibleRec0(self, explored, i, j - 1)) return true;
+    // Masques du plateau, de sa dernière ligne et de sa première colonne.
+    QuoridorMask row = { ((uint64_t)1 << gridSize) - 1, 0 };
+    QuoridorMask board = QuoridorMask_zero();
+    QuoridorMask lastRow = QuoridorMask_zero();
+    QuoridorMask firstCol = QuoridorMask_zero();
+    for (int i = 0; i < gridSize; i++)
+    {
+        board = QuoridorMask_or(board, row);
+        lastRow = row;
+        QuoridorMask_set(&firstCol, i * MAX_GRID_SIZE);
+        if (i < gridSize - 1) row = QuoridorMask_shl(row, MAX_GRID_SIZE);
+    }
+    QuoridorMask lastCol = QuoridorMask_shl(firstCol, gridSize - 1);
 
-    return false;
+    masks->canDown = QuoridorMask_andNot(board, QuoridorMask_or(blockedDown, lastRow));
+    masks->canRight = QuoridorMask_andNot(board, QuoridorMask_or(blockedRight, lastCol));
+    masks->goals[0] = lastCol;
+    masks->goals[1] = firstCol;
+    masks->wallSlots = QuoridorMask_andNot(board, QuoridorMask_or(lastRow, lastCol));
 }
 
-static bool QuoridorCore_isFeasibleRec1(QuoridorCore *self, bool explored[MAX_GRID_SIZE][MAX_GRID_SIZE], int i, int j)
+/// @brief Renvoie un ensemble de cases étendu à toutes leurs voisines accessibles.
+static QuoridorMask QuoridorCore_expand(QuoridorMask cells, QuoridorMask canDown, QuoridorMask canRight)
 {
-    const int gridSize = self->gridSize;
-    if (j <= 0) return true;
+    QuoridorMask down = QuoridorMask_shl(QuoridorMask_and(cells, canDown), MAX_GRID_SIZE);
+    QuoridorMask up = QuoridorMask_and(QuoridorMask_shr(cells, MAX_GRID_SIZE), canDown);
+    QuoridorMask right = QuoridorMask_shl(QuoridorMask_and(cells, canRight), 1);
+    QuoridorMask left = QuoridorMask_and(QuoridorMask_shr(cells, 1), canRight);
 
-    // TODO
-    // Fonction récursive vérifiant qu'il existe un chemin permettant au joueur 1 de terminer la partie.
-    // Cette fonction réalise un parcours en profondeur.
-    // Ordonnez les cases voisines à explorer pour améliorer les performances.
-    explored[i][j] = true;
+    return QuoridorMask_or(QuoridorMask_or(cells, down), QuoridorMask_or(up, QuoridorMask_or(right, left)));
+}
 
-    if (!explored[i][j - 1] && !QuoridorCore_hasWallLeft(self, i, j) && QuoridorCore_isFeasibleRec1(self, explored, i, j - 1)) return true;
-    if (!explored[i - 1][j] && !QuoridorCore_hasWallAbove(self, i, j) && QuoridorCore_isFeasibleRec1(self, explored, i - 1, j)) return true;
-    if (!explored[i + 1][j] && !QuoridorCore_hasWallBelow(self, i, j) && QuoridorCore_isFeasibleRec1(self, explored, i + 1, j)) return true;
-    if (!explored[i][j + 1] && !QuoridorCore_hasWallRight(self, i, j) && QuoridorCore_isFeasibleRec1(self, explored, i, j + 1)) return true;
+/// @brief Indique si une case d'arrivée est atteignable depuis une position.
+/// L'ensemble des cases atteignables est étendu simultanément dans les quatre directions
+/// à l'aide de décalages de bits, jusqu'à atteindre la cible ou jusqu'à ce qu'il ne grossisse plus.
+/// @param start Position de départ.
+/// @param target Masque des cases d'arrivée.
+/// @param canDown Masque des cases dont on peut descendre.
+/// @param canRight Masque des cases dont on peut aller à droite.
+/// @return true si une case de target est atteignable, false sinon.
+static bool QuoridorCore_floodFill(QuoridorPos start, QuoridorMask target, QuoridorMask canDown, QuoridorMask canRight)
+{
+    QuoridorMask reached = QuoridorMask_bit(start.i * MAX_GRID_SIZE + start.j);
+    QuoridorMask previous;
+
+    do
+    {
+        if (!QuoridorMask_isZero(QuoridorMask_and(reached, target)))
+            return true;
+
+        previous = reached;
+        reached = QuoridorCore_expand(reached, canDown, canRight);
+    } while (!QuoridorMask_equals(reached, previous));
 
     return false;
 }
 
-bool QuoridorCore_isFeasible(QuoridorCore *self)
+/// @brief Calcule un plus court chemin vers une case d'arrivée et renvoie les passages qu'il emprunte.
+/// Le parcours en largeur est réalisé couche par couche sur les masques,
+/// puis le chemin est reconstruit depuis l'arrivée en remontant les couches.
+/// @param start Position de départ.
+/// @param target Masque des cases d'arrivée.
+/// @param masks Masques des déplacements possibles.
+/// @param downEdges Masque dans lequel sont écrites les cases quittées vers le bas (ou atteintes par le haut).
+/// @param rightEdges Masque dans lequel sont écrites les cases quittées vers la droite (ou atteintes par la gauche).
+/// @return true si un chemin existe, false sinon.
+static bool QuoridorCore_getPathEdges(
+    QuoridorPos start, QuoridorMask target, const QuoridorMoveMasks *masks,
+    QuoridorMask *downEdges, QuoridorMask *rightEdges)
 {
-    bool explored[MAX_GRID_SIZE][MAX_GRID_SIZE] = { 0 };
+    QuoridorMask layers[MAX_GRID_SIZE * MAX_GRID_SIZE];
+    QuoridorMask reached = QuoridorMask_bit(start.i * MAX_GRID_SIZE + start.j);
+    int depth = 0;
 
-    // TODO
-    if (!QuoridorCore_isFeasibleRec0(self, explored, self->positions[0].i, self->positions[0].j)) return false;
+    layers[0] = reached;
+    while (QuoridorMask_isZero(QuoridorMask_and(layers[depth], target)))
+    {
+        QuoridorMask next = QuoridorCore_expand(layers[depth], masks->canDown, masks->canRight);
+        next = QuoridorMask_andNot(next, reached);
+        if (QuoridorMask_isZero(next))
+            return false;
+
+        reached = QuoridorMask_or(reached, next);
+        layers[++depth] = next;
+    }
+
+    *downEdges = QuoridorMask_zero();
+    *rightEdges = QuoridorMask_zero();
 
-    memset(explored, 0, sizeof(explored));
+    QuoridorMask arrival = QuoridorMask_and(layers[depth], target);
+    int k = QuoridorMask_popLSB(&arrival);
+    for (int d = depth - 1; d >= 0; d--)
+    {
+        const QuoridorMask layer = layers[d];
+        if (k >= MAX_GRID_SIZE && QuoridorMask_test(layer, k - MAX_GRID_SIZE)
+            && QuoridorMask_test(masks->canDown, k - MAX_GRID_SIZE))
+        {
+            k -= MAX_GRID_SIZE;
+            QuoridorMask_set(downEdges, k);
+        }
+        else if (k + MAX_GRID_SIZE < 128 && QuoridorMask_test(layer, k + MAX_GRID_SIZE)
+            && QuoridorMask_test(masks->canDown, k))
+        {
+            QuoridorMask_set(downEdges, k);
+            k += MAX_GRID_SIZE;
+        }
+        else if (k >= 1 && QuoridorMask_test(layer, k - 1) && QuoridorMask_test(masks->canRight, k - 1))
+        {
+            k -= 1;
+            QuoridorMask_set(rightEdges, k);
+        }
+        else
+        {
+            assert(QuoridorMask_test(layer, k + 1) && QuoridorMask_test(masks->canRight, k));
+            QuoridorMask_set(rightEdges, k);
+            k += 1;
+        }
+    }
+
+    return true;
+}
+
+bool QuoridorCore_isFeasible(QuoridorCore *self)
+{
+    QuoridorMoveMasks masks;
+    QuoridorCore_getMoveMasks(self, &masks);
 
-    if (!QuoridorCore_isFeasibleRec1(self, explored, self->positions[1].i, self->positions[1].j)) return false;
+    if (!QuoridorCore_floodFill(self->positions[0], masks.goals[0], masks.canDown, masks.canRight)) return false;
+    if (!QuoridorCore_floodFill(self->positions[1], masks.goals[1], masks.canDown, masks.canRight)) return false;
 
     return true;
 }
 
+void QuoridorCore_generateLegalWalls(QuoridorCore *self, QuoridorMask *hMask, QuoridorMask *vMask)
+{
+    *hMask = QuoridorMask_zero();
+    *vMask = QuoridorMask_zero();
+
+    if (self->wallCounts[self->playerID] <= 0) return;
+
+    QuoridorMoveMasks masks;
+    QuoridorCore_getMoveMasks(self, &masks);
+
+    // Chevauchements et croisements :
+    // un mur horizontal en (i,j) est incompatible avec les murs horizontaux en (i,j-1), (i,j), (i,j+1)
+    // et avec le mur vertical en (i,j) (et symétriquement pour un mur vertical).
+    const QuoridorMask h = self->hWalls;
+    const QuoridorMask v = self->vWalls;
+
+    QuoridorMask hBlocked = QuoridorMask_or(QuoridorMask_or(h, v), QuoridorMask_or(QuoridorMask_shl(h, 1), QuoridorMask_shr(h, 1)));
+    QuoridorMask vBlocked = QuoridorMask_or(QuoridorMask_or(v, h), QuoridorMask_or(QuoridorMask_shl(v, MAX_GRID_SIZE), QuoridorMask_shr(v, MAX_GRID_SIZE)));
+
+    QuoridorMask hFree = QuoridorMask_andNot(masks.wallSlots, hBlocked);
+    QuoridorMask vFree = QuoridorMask_andNot(masks.wallSlots, vBlocked);
+
+    // Un mur qui ne coupe aucun passage d'un plus court chemin de chaque joueur laisse ces chemins intacts :
+    // seuls les murs touchant l'un des deux chemins nécessitent un test d'accessibilité.
+    QuoridorMask hTouch = QuoridorMask_zero();
+    QuoridorMask vTouch = QuoridorMask_zero();
+    for (int playerID = 0; playerID < 2; playerID++)
+    {
+        QuoridorMask downEdges, rightEdges;
+        if (!QuoridorCore_getPathEdges(self->positions[playerID], masks.goals[playerID], &masks, &downEdges, &rightEdges))
+        {
+            hTouch = hFree;
+            vTouch = vFree;
+            break;
+        }
+
+        // Le mur horizontal en (i,j) coupe les descentes depuis (i,j) et (i,j+1).
+        // Le mur vertical en (i,j) coupe les passages vers la droite depuis (i,j) et (i+1,j).
+        hTouch = QuoridorMask_or(hTouch, QuoridorMask_or(downEdges, QuoridorMask_shr(downEdges, 1)));
+        vTouch = QuoridorMask_or(vTouch, QuoridorMask_or(rightEdges, QuoridorMask_shr(rightEdges, MAX_GRID_SIZE)));
+    }
+
+    *hMask = QuoridorMask_andNot(hFree, hTouch);
+    *vMask = QuoridorMask_andNot(vFree, vTouch);
+
+    QuoridorMask hCheck = QuoridorMask_and(hFree, hTouch);
+    while (!QuoridorMask_isZero(hCheck))
+    {
+        const int k = QuoridorMask_popLSB(&hCheck);
+        QuoridorMask canDown = masks.canDown;
+        QuoridorMask_reset(&canDown, k);
+        QuoridorMask_reset(&canDown, k + 1);
+
+        if (QuoridorCore_floodFill(self->positions[0], masks.goals[0], canDown, masks.canRight) &&
+            QuoridorCore_floodFill(self->positions[1], masks.goals[1], canDown, masks.canRight))
+        {
+            QuoridorMask_set(hMask, k);
+        }
+    }
+
+    QuoridorMask vCheck = QuoridorMask_and(vFree, vTouch);
+    while (!QuoridorMask_isZero(vCheck))
+    {
+        const int k = QuoridorMask_popLSB(&vCheck);
+        QuoridorMask canRight = masks.canRight;
+        QuoridorMask_reset(&canRight, k);
+        QuoridorMask_reset(&canRight, k + MAX_GRID_SIZE);
+
+        if (QuoridorCore_floodFill(self->positions[0], masks.goals[0], masks.canDown, canRight) &&
+            QuoridorCore_floodFill(self->positions[1], masks.goals[1], masks.canDown, canRight))
+        {
+            QuoridorMask_set(vMask, k);
+        }
+    }
+}
+
 bool QuoridorCore_canMoveTo(QuoridorCore *self, int nextI, int nextJ)
 {
     const int gridSize = self->gridSize;
     if (nextI < 0 || nextI >= gridSize) return false;
     if (nextJ < 0 || nextJ >= gridSize) return false;
     if (self->state != QUORIDOR_STATE_IN_PROGRESS) return false;
-    return self->isValid[nextI][nextJ];
+
+    const QuoridorPos pos = self->positions[self->playerID];
+    const int k = QuoridorCore_getMoveIndex(nextI - pos.i, nextJ - pos.j);
+    return (k >= 0) && ((self->validMoves >> k) & 1);
 }
 
 void QuoridorCore_playWall(QuoridorCore *self, WallType type, int i, int j)
@@ -261,34 +696,41 @@ void QuoridorCore_playWall(QuoridorCore *self, WallType type, int i, int j)
     assert(0 <= j && j < self->gridSize - 1);
     assert(self->wallCounts[self->playerID] > 0);
     
-    // TODO
+    const int k = i * MAX_GRID_SIZE + j;
+    int cutEdges[2][2];
     switch (type)
     {
     case WALL_TYPE_VERTICAL:
-        self->vWalls[i][j] = WALL_STATE_START;
-        self->vWalls[i + 1][j] = WALL_STATE_END;
+        cutEdges[0][0] = k;
+        cutEdges[0][1] = k + 1;
+        cutEdges[1][0] = k + MAX_GRID_SIZE;
+        cutEdges[1][1] = k + MAX_GRID_SIZE + 1;
+        QuoridorMask_set(&self->vWalls, k);
+        self->hashKey ^= QuoridorCore_getZobristKey(ZOBRIST_V_WALL + k);
 #if DEBUG
-        self->vWallOwners[i][j] = self->playerID;
-        self->vWallOwners[i + 1][j] = self->playerID;
+        if (self->playerID) QuoridorMask_set(&self->vWallOwners, k);
 #endif
         break;
-    case WALL_TYPE_VERTICAL_TEMP:
-		self->vWalls[i][j] = WALL_STATE_TEMP;
-		return;
-    case WALL_TYPE_HORIZONTAL_TEMP:
-        self->hWalls[i][j] = WALL_STATE_TEMP;
-        return;
     default:
-        self->hWalls[i][j] = WALL_STATE_START;
-        self->hWalls[i][j+1] = WALL_STATE_END;
+        cutEdges[0][0] = k;
+        cutEdges[0][1] = k + MAX_GRID_SIZE;
+        cutEdges[1][0] = k + 1;
+        cutEdges[1][1] = k + MAX_GRID_SIZE + 1;
+        QuoridorMask_set(&self->hWalls, k);
+        self->hashKey ^= QuoridorCore_getZobristKey(ZOBRIST_H_WALL + k);
 #if DEBUG
-        self->hWallOwners[i][j] = self->playerID;
-        self->hWallOwners[i][j+1] = self->playerID;
+        if (self->playerID) QuoridorMask_set(&self->hWallOwners, k);
 #endif
         break;
     }
-    
+
+    QuoridorCore_updateDistances(self, 0, cutEdges);
+    QuoridorCore_updateDistances(self, 1, cutEdges);
+
+    self->hashKey ^= QuoridorCore_getWallCountKey(self->playerID, self->wallCounts[self->playerID]);
     self->wallCounts[self->playerID]--;
+    self->hashKey ^= QuoridorCore_getWallCountKey(self->playerID, self->wallCounts[self->playerID]);
+    self->hashKey ^= QuoridorCore_getZobristKey(ZOBRIST_SIDE);
     self->playerID ^= 1;
     QuoridorCore_updateValidMoves(self);
 }
@@ -298,12 +740,10 @@ void QuoridorCore_moveTo(QuoridorCore *self, int i, int j)
     assert(0 <= i && i < self->gridSize);
     assert(0 <= j && j < self->gridSize);
 
-
-    // TODO Done
-    // Déplacez le pion.
-    // Changez l'état de la partie si le joueur vient de gagner.
+    self->hashKey ^= QuoridorCore_getPawnKey(self->playerID, self->positions[self->playerID]);
     self->positions[self->playerID].i = i;
     self->positions[self->playerID].j = j;
+    self->hashKey ^= QuoridorCore_getPawnKey(self->playerID, self->positions[self->playerID]);
 
     if (!self->playerID && j == self->gridSize - 1)
         self->state = QUORIDOR_STATE_P0_WON;
@@ -311,6 +751,7 @@ void QuoridorCore_moveTo(QuoridorCore *self, int i, int j)
         self->state = QUORIDOR_STATE_P1_WON;
 
 
+    self->hashKey ^= QuoridorCore_getZobristKey(ZOBRIST_SIDE);
     self->playerID ^= 1;
     QuoridorCore_updateValidMoves(self);
 }
@@ -334,6 +775,119 @@ void QuoridorCore_playTurn(QuoridorCore *self, QuoridorTurn turn)
     }
 }
 
+bool QuoridorCore_canPlayTurn(QuoridorCore *self, QuoridorTurn turn)
+{
+    switch (turn.action)
+    {
+    case QUORIDOR_MOVE_TO:
+        return QuoridorCore_canMoveTo(self, turn.i, turn.j);
+    case QUORIDOR_PLAY_HORIZONTAL_WALL:
+        return QuoridorCore_canPlayWall(self, WALL_TYPE_HORIZONTAL, turn.i, turn.j);
+    case QUORIDOR_PLAY_VERTICAL_WALL:
+        return QuoridorCore_canPlayWall(self, WALL_TYPE_VERTICAL, turn.i, turn.j);
+    default:
+        return false;
+    }
+}
+
+void QuoridorTurn_toString(QuoridorTurn turn, char *buffer)
+{
+    const char *suffix = "";
+    if (turn.action == QUORIDOR_PLAY_HORIZONTAL_WALL) suffix = "h";
+    else if (turn.action == QUORIDOR_PLAY_VERTICAL_WALL) suffix = "v";
+
+    if (turn.action == QUORIDOR_ACTION_UNDEFINED)
+        snprintf(buffer, QUORIDOR_TURN_STRING_SIZE, "none");
+    else
+        snprintf(buffer, QUORIDOR_TURN_STRING_SIZE, "%c%c%s", 'a' + turn.j, '1' + turn.i, suffix);
+}
+
+bool QuoridorTurn_fromString(QuoridorTurn *turn, const char *str)
+{
+    if (str[0] < 'a' || str[0] >= 'a' + MAX_GRID_SIZE)
+        return false;
+    if (str[1] < '1' || str[1] > '0' + MAX_GRID_SIZE)
+        return false;
+
+    turn->j = str[0] - 'a';
+    turn->i = str[1] - '1';
+
+    switch (str[2])
+    {
+    case '\0':
+        turn->action = QUORIDOR_MOVE_TO;
+        return true;
+    case 'h':
+        turn->action = QUORIDOR_PLAY_HORIZONTAL_WALL;
+        return str[3] == '\0';
+    case 'v':
+        turn->action = QUORIDOR_PLAY_VERTICAL_WALL;
+        return str[3] == '\0';
+    default:
+        return false;
+    }
+}
+
+void QuoridorCore_makeTurn(QuoridorCore *self, QuoridorTurn turn, QuoridorUndo *undo)
+{
+    undo->position = self->positions[self->playerID];
+    undo->validMoves = self->validMoves;
+    undo->playerID = self->playerID;
+    undo->state = self->state;
+    undo->hashKey = self->hashKey;
+
+    switch (turn.action)
+    {
+    case QUORIDOR_MOVE_TO:
+        QuoridorCore_moveTo(self, turn.i, turn.j);
+        break;
+    case QUORIDOR_PLAY_HORIZONTAL_WALL:
+        memcpy(undo->distances, self->distances, sizeof(self->distances));
+        QuoridorCore_playWall(self, WALL_TYPE_HORIZONTAL, turn.i, turn.j);
+        break;
+    case QUORIDOR_PLAY_VERTICAL_WALL:
+        memcpy(undo->distances, self->distances, sizeof(self->distances));
+        QuoridorCore_playWall(self, WALL_TYPE_VERTICAL, turn.i, turn.j);
+        break;
+    default:
+        break;
+    }
+}
+
+void QuoridorCore_unmakeTurn(QuoridorCore *self, QuoridorTurn turn, const QuoridorUndo *undo)
+{
+    const int playerID = undo->playerID;
+    const int k = turn.i * MAX_GRID_SIZE + turn.j;
+
+    switch (turn.action)
+    {
+    case QUORIDOR_PLAY_HORIZONTAL_WALL:
+        QuoridorMask_reset(&self->hWalls, k);
+#if DEBUG
+        QuoridorMask_reset(&self->hWallOwners, k);
+#endif
+        memcpy(self->distances, undo->distances, sizeof(self->distances));
+        self->wallCounts[playerID]++;
+        break;
+    case QUORIDOR_PLAY_VERTICAL_WALL:
+        QuoridorMask_reset(&self->vWalls, k);
+#if DEBUG
+        QuoridorMask_reset(&self->vWallOwners, k);
+#endif
+        memcpy(self->distances, undo->distances, sizeof(self->distances));
+        self->wallCounts[playerID]++;
+        break;
+    default:
+        break;
+    }
+
+    self->positions[playerID] = undo->position;
+    self->validMoves = undo->validMoves;
+    self->playerID = playerID;
+    self->state = undo->state;
+    self->hashKey = undo->hashKey;
+}
+
 void QuoridorCore_print(QuoridorCore *self)
 {
     const int gridSize = self->gridSize;
@@ -355,9 +909,10 @@ void QuoridorCore_print(QuoridorCore *self)
             else
                 printf(".");
 
-            if (self->vWalls[i][j] == WALL_STATE_START)
+            WallState vState = QuoridorCore_getWallState(self, WALL_TYPE_VERTICAL, i, j);
+            if (vState == WALL_STATE_START)
                 printf("A");
-            else if (self->vWalls[i][j] == WALL_STATE_END)
+            else if (vState == WALL_STATE_END)
                 printf("B");
             else
                 printf("|");
@@ -366,11 +921,12 @@ void QuoridorCore_print(QuoridorCore *self)
 
         for (int j = 0; j < gridSize; j++)
         {
-            if (self->hWalls[i][j] == WALL_STATE_START)
+            WallState hState = QuoridorCore_getWallState(self, WALL_TYPE_HORIZONTAL, i, j);
+            if (hState == WALL_STATE_START)
                 printf("A=");
-            else if (self->hWalls[i][j] == WALL_STATE_END)
+            else if (hState == WALL_STATE_END)
                 printf("B|");
-            else if (self->vWalls[i][j] == WALL_STATE_START)
+            else if (QuoridorCore_getWallState(self, WALL_TYPE_VERTICAL, i, j) == WALL_STATE_START)
                 printf("-#");
             else
                 printf("-+");
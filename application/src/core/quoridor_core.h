@@ -6,7 +6,8 @@
 
 #pragma once
 
-#include "settings.h"
+#include "core/core_settings.h"
+#include "core/quoridor_mask.h"
 
 /// @brief Taille maximale (largeur et hauteur) du plateau du jeu Quoridor.
 #define MAX_GRID_SIZE 9
@@ -14,6 +15,9 @@
 /// @brief Longueur maximale d'un chemin sur le plateau.
 #define MAX_PATH_LEN 82
 
+/// @brief Distance d'une case depuis laquelle la zone d'arrivée est inaccessible.
+#define QUORIDOR_DISTANCE_INFINITE 255
+
 typedef enum WallState
 {
     /// @brief Indique l'absence d'un mur.
@@ -26,11 +30,6 @@ typedef enum WallState
     /// @brief Indique la fin d'un mur
     /// (partie droite pour un mur horizontal, partie basse pour un mur vertical).
     WALL_STATE_END,
-
-    /// @biref Mur temporaire.
-    /// indique que le mur est temporaire et ne doit pas être pris en compte
-    WALL_STATE_TEMP
-
 } WallState;
 
 typedef enum WallType
@@ -40,12 +39,6 @@ typedef enum WallType
 
     /// @brief Mur vertical.
     WALL_TYPE_VERTICAL,
-
-    /// @biref Mur horizontal temporaire.
-    WALL_TYPE_HORIZONTAL_TEMP,
-
-    /// @biref Mur vertical temporaire.
-    WALL_TYPE_VERTICAL_TEMP,
 } WallType;
 
 typedef enum QuoridorState
@@ -68,50 +61,68 @@ typedef enum QuoridorState
 typedef struct QuoridorPos
 {
     /// @brief Indice de la ligne (0 pour la ligne supérieure).
-    int i;
+    int8_t i;
 
     /// @brief Indice de la colonne (0 pour la colonne de gauche).
-    int j;
+    int8_t j;
 } QuoridorPos;
 
+/// @brief Nombre de cases relatives vers lesquelles un pion peut se déplacer
+/// (4 pas simples, 4 sauts par-dessus l'adversaire et 4 diagonales).
+#define QUORIDOR_MOVE_COUNT 12
+
 /// @brief Représente l'état complet du jeu Quoridor.
+/// L'état est compact (56 octets, plus 162 octets de champs de distances)
+/// pour que les copies effectuées par la recherche restent peu coûteuses.
 typedef struct QuoridorCore
 {
-    /// @brief Taille de la grille (<= MAX_GRID_SIZE).
-    int gridSize;
-
-    /// @brief État actuel de la partie.
-    QuoridorState state;
+    /// @brief Murs horizontaux placés sur le plateau.
+    /// Le bit (i * MAX_GRID_SIZE + j) vaut 1 si un mur commence sous la case [i,j] ;
+    /// il bloque alors le passage sous les cases [i,j] et [i,j+1].
+    QuoridorMask hWalls;
 
     /// @brief Murs verticaux placés sur le plateau.
-    WallState vWalls[MAX_GRID_SIZE][MAX_GRID_SIZE];
+    /// Le bit (i * MAX_GRID_SIZE + j) vaut 1 si un mur commence à droite de la case [i,j] ;
+    /// il bloque alors le passage à droite des cases [i,j] et [i+1,j].
+    QuoridorMask vWalls;
 
-    /// @brief Murs horizontaux placés sur le plateau.
-    WallState hWalls[MAX_GRID_SIZE][MAX_GRID_SIZE];
+    /// @brief Clé de Zobrist identifiant la position.
+    /// Elle prend en compte les murs, la position des pions, le joueur courant,
+    /// le nombre de murs restants et la taille de la grille.
+    /// Elle est mise à jour de façon incrémentale à chaque tour.
+    uint64_t hashKey;
 
 #if DEBUG
-    int hWallOwners[MAX_GRID_SIZE][MAX_GRID_SIZE]; // 0 ou 1 selon le joueur
-    int vWallOwners[MAX_GRID_SIZE][MAX_GRID_SIZE];
+    /// @brief Propriétaires des murs (bit à 1 si le mur a été posé par le joueur 1).
+    QuoridorMask hWallOwners;
+    QuoridorMask vWallOwners;
 #endif
 
-    /// @brief Cases vers lesquelles le joueur courant peut se déplacer.
-    /// Si isValid[i][j] vaut true, la case [i,j] est accessible.
-    bool isValid[MAX_GRID_SIZE][MAX_GRID_SIZE];
-
-    /// @brief Etat du plateau en mode Review.
-    /// 0 : case vide 
-    /// 1: Ancienne position 
-    /// 2: Position idéale
-    int reviewCore[MAX_GRID_SIZE][MAX_GRID_SIZE];
-
-    /// @brief Identifiant du joueur courant (0 ou 1).
-    int playerID;
-
     /// @brief Position actuelle du pion de chaque joueur.
     QuoridorPos positions[2];
 
     /// @brief Nombre de murs restants pour chaque joueur.
-    int wallCounts[2];
+    int8_t wallCounts[2];
+
+    /// @brief Taille de la grille (<= MAX_GRID_SIZE).
+    int8_t gridSize;
+
+    /// @brief État actuel de la partie (voir QuoridorState).
+    int8_t state;
+
+    /// @brief Identifiant du joueur courant (0 ou 1).
+    int8_t playerID;
+
+    /// @brief Cases vers lesquelles le joueur courant peut se déplacer.
+    /// Le bit k vaut 1 si la case située au décalage QuoridorCore_getMoveOffset(k)
+    /// de la position du joueur courant est accessible.
+    uint16_t validMoves;
+
+    /// @brief Distance de chaque case à la zone d'arrivée de chaque joueur, en tenant compte des murs
+    /// mais pas des pions. La case [i,j] correspond à l'indice (i * MAX_GRID_SIZE + j).
+    /// Vaut QUORIDOR_DISTANCE_INFINITE si la zone d'arrivée est inaccessible depuis la case.
+    /// Ces champs sont mis à jour de façon incrémentale à chaque pose de mur.
+    uint8_t distances[2][MAX_GRID_SIZE * MAX_GRID_SIZE];
 } QuoridorCore;
 
 /// @brief Crée une instance du jeu Quoridor.
@@ -134,6 +145,11 @@ void QuoridorCore_reset(QuoridorCore *self, int gridSize, int wallCount, int fir
 /// @param self Instance du jeu Quoridor.
 void QuoridorCore_randomStart(QuoridorCore *self);
 
+/// @brief Recalcule les déplacements possibles du joueur courant (champ validMoves).
+/// Cette fonction est appelée par toutes les fonctions qui modifient le plateau.
+/// @param self Instance du jeu Quoridor.
+void QuoridorCore_updateValidMoves(QuoridorCore *self);
+
 /// @brief Vérifie si le joueur courant peut poser un mur.
 /// @param self Instance du jeu Quoridor.
 /// @param type Type de mur (horizontal ou vertical).
@@ -142,6 +158,15 @@ void QuoridorCore_randomStart(QuoridorCore *self);
 /// @return true si l'action est possible, false sinon.
 bool QuoridorCore_canPlayWall(QuoridorCore *self, WallType type, int i, int j);
 
+/// @brief Calcule l'ensemble des murs que le joueur courant peut poser.
+/// Les chevauchements et croisements sont testés pour tous les emplacements à la fois,
+/// et le test d'accessibilité n'est effectué que pour les murs coupant un plus court chemin de l'un des joueurs.
+/// Le résultat est identique à celui de QuoridorCore_canPlayWall() appliqué à chaque emplacement.
+/// @param self Instance du jeu Quoridor.
+/// @param hMask Masque dans lequel sont écrits les murs horizontaux possibles (bit i * MAX_GRID_SIZE + j).
+/// @param vMask Masque dans lequel sont écrits les murs verticaux possibles (bit i * MAX_GRID_SIZE + j).
+void QuoridorCore_generateLegalWalls(QuoridorCore *self, QuoridorMask *hMask, QuoridorMask *vMask);
+
 /// @brief Vérifie si le joueur courant peut se déplacer vers une case.
 /// @param self Instance du jeu Quoridor.
 /// @param i Ligne cible.
@@ -170,6 +195,13 @@ void QuoridorCore_moveTo(QuoridorCore *self, int i, int j);
 /// @param self Instance du jeu Quoridor.
 void QuoridorCore_print(QuoridorCore *self);
 
+/// @brief Recalcule entièrement la clé de Zobrist de la position.
+/// La clé est normalement maintenue de façon incrémentale dans hashKey ;
+/// cette fonction sert à l'initialiser ou à la vérifier.
+/// @param self Instance du jeu Quoridor.
+/// @return La clé de Zobrist de la position.
+uint64_t QuoridorCore_computeHash(QuoridorCore *self);
+
 typedef enum QuoridorAction
 {
     /// @brief Action non définie.
@@ -205,18 +237,105 @@ typedef struct QuoridorTurn
 /// @param turn Action à effectuer.
 void QuoridorCore_playTurn(QuoridorCore *self, QuoridorTurn turn);
 
+/// @brief Pose des murs de départ (par exemple ceux de QuoridorCore_randomStart()).
+/// Les murs sont posés alternativement par chaque joueur, en commençant par le joueur courant,
+/// et chaque joueur reçoit auparavant les murs qu'il pose : le nombre de murs restants ne change pas.
+/// Le joueur courant change si le nombre de murs est impair.
+/// À appeler juste après QuoridorCore_reset().
+/// @param self Instance du jeu Quoridor.
+/// @param walls Murs à poser (actions QUORIDOR_PLAY_HORIZONTAL_WALL ou QUORIDOR_PLAY_VERTICAL_WALL).
+/// @param wallCount Nombre de murs.
+/// @return true si tous les murs ont pu être posés, false sinon (le plateau est alors incomplet).
+bool QuoridorCore_playStartWalls(QuoridorCore *self, const QuoridorTurn *walls, int wallCount);
 
-/// @brief Vérifie s'il y a un mur horizontal au-dessus de [i,j].
-/// Le bord supérieur est considéré comme un mur.
+/// @brief Vérifie si le joueur courant peut jouer un tour.
+/// @param self Instance du jeu Quoridor.
+/// @param turn Action à vérifier.
+/// @return true si l'action est possible, false sinon.
+bool QuoridorCore_canPlayTurn(QuoridorCore *self, QuoridorTurn turn);
+
+/// @brief Taille du tampon nécessaire à l'écriture d'un tour avec QuoridorTurn_toString().
+#define QUORIDOR_TURN_STRING_SIZE 8
+
+/// @brief Écrit un tour en notation algébrique :
+/// la colonne est une lettre ('a' pour j = 0) et la ligne un nombre (1 pour i = 0).
+/// Un déplacement est noté par sa case d'arrivée ("e2"), un mur par sa case de départ suivie
+/// de 'h' (horizontal) ou 'v' (vertical), par exemple "c3h".
+/// @param turn Tour à écrire.
+/// @param buffer Tampon de taille QUORIDOR_TURN_STRING_SIZE.
+void QuoridorTurn_toString(QuoridorTurn turn, char *buffer);
+
+/// @brief Lit un tour écrit en notation algébrique (voir QuoridorTurn_toString()).
+/// La validité du tour sur un plateau n'est pas vérifiée.
+/// @param turn Adresse dans laquelle est écrit le tour lu.
+/// @param str Chaîne à lire.
+/// @return true si la chaîne est un tour bien formé, false sinon.
+bool QuoridorTurn_fromString(QuoridorTurn *turn, const char *str);
+
+/// @brief Informations nécessaires pour annuler un tour avec QuoridorCore_unmakeTurn().
+typedef struct QuoridorUndo
+{
+    /// @brief Position du joueur avant le tour.
+    QuoridorPos position;
+
+    /// @brief Cases accessibles avant le tour.
+    uint16_t validMoves;
+
+    /// @brief Identifiant du joueur ayant joué le tour.
+    int8_t playerID;
+
+    /// @brief État de la partie avant le tour.
+    int8_t state;
+
+    /// @brief Clé de Zobrist avant le tour.
+    uint64_t hashKey;
+
+    /// @brief Champs de distances avant le tour.
+    /// Ils ne sont sauvegardés que pour la pose d'un mur (un déplacement ne les modifie pas).
+    uint8_t distances[2][MAX_GRID_SIZE * MAX_GRID_SIZE];
+} QuoridorUndo;
+
+/// @brief Joue le tour du joueur courant en mémorisant de quoi l'annuler.
+/// Contrairement à une copie complète du plateau, seules les données modifiées par le tour sont sauvegardées.
+/// Cette fonction ne vérifie pas la validité du coup.
+/// @param self Instance du jeu Quoridor.
+/// @param turn Action à effectuer.
+/// @param undo Adresse dans laquelle sont écrites les informations d'annulation.
+void QuoridorCore_makeTurn(QuoridorCore *self, QuoridorTurn turn, QuoridorUndo *undo);
+
+/// @brief Annule un tour joué avec QuoridorCore_makeTurn().
+/// Les tours doivent être annulés dans l'ordre inverse de celui dans lequel ils ont été joués.
+/// @param self Instance du jeu Quoridor.
+/// @param turn Action à annuler.
+/// @param undo Informations d'annulation renvoyées par QuoridorCore_makeTurn().
+void QuoridorCore_unmakeTurn(QuoridorCore *self, QuoridorTurn turn, const QuoridorUndo *undo);
+
+
+/// @brief Renvoie l'état d'un emplacement de mur.
+/// Les indices peuvent être hors du plateau (l'emplacement est alors vide).
 /// @param self Instance du jeu Quoridor.
+/// @param type Type de mur (horizontal ou vertical).
 /// @param i Ligne.
 /// @param j Colonne.
-/// @return true s'il y a un mur, false sinon.
-INLINE bool QuoridorCore_hasWallAbove(QuoridorCore *self, int i, int j)
+/// @return WALL_STATE_START si un mur commence en [i,j],
+///     WALL_STATE_END si un mur s'y termine et WALL_STATE_NONE sinon.
+INLINE WallState QuoridorCore_getWallState(QuoridorCore *self, WallType type, int i, int j)
 {
-    assert(0 <= i && i < self->gridSize);
-    assert(0 <= j && j < self->gridSize);
-    return (i > 0) ? self->hWalls[i - 1][j] : true;
+    if (i < 0 || i >= self->gridSize || j < 0 || j >= self->gridSize)
+        return WALL_STATE_NONE;
+
+    const int k = i * MAX_GRID_SIZE + j;
+    if (type == WALL_TYPE_HORIZONTAL)
+    {
+        if (QuoridorMask_test(self->hWalls, k)) return WALL_STATE_START;
+        if (j > 0 && QuoridorMask_test(self->hWalls, k - 1)) return WALL_STATE_END;
+    }
+    else
+    {
+        if (QuoridorMask_test(self->vWalls, k)) return WALL_STATE_START;
+        if (i > 0 && QuoridorMask_test(self->vWalls, k - MAX_GRID_SIZE)) return WALL_STATE_END;
+    }
+    return WALL_STATE_NONE;
 }
 
 /// @brief Vérifie s'il y a un mur horizontal en dessous de [i,j].
@@ -229,20 +348,21 @@ INLINE bool QuoridorCore_hasWallBelow(QuoridorCore *self, int i, int j)
 {
     assert(0 <= i && i < self->gridSize);
     assert(0 <= j && j < self->gridSize);
-    return (i < self->gridSize - 1) ? self->hWalls[i][j] : true;
+    if (i >= self->gridSize - 1) return true;
+
+    const int k = i * MAX_GRID_SIZE + j;
+    return QuoridorMask_test(self->hWalls, k) || (j > 0 && QuoridorMask_test(self->hWalls, k - 1));
 }
 
-/// @brief Vérifie s'il y a un mur vertical à gauche de [i,j].
-/// Le bord gauche est considéré comme un mur.
+/// @brief Vérifie s'il y a un mur horizontal au-dessus de [i,j].
+/// Le bord supérieur est considéré comme un mur.
 /// @param self Instance du jeu Quoridor.
 /// @param i Ligne.
 /// @param j Colonne.
 /// @return true s'il y a un mur, false sinon.
-INLINE bool QuoridorCore_hasWallLeft(QuoridorCore *self, int i, int j)
+INLINE bool QuoridorCore_hasWallAbove(QuoridorCore *self, int i, int j)
 {
-    assert(0 <= i && i < self->gridSize);
-    assert(0 <= j && j < self->gridSize);
-    return (j > 0) ? self->vWalls[i][j - 1] : true;
+    return (i > 0) ? QuoridorCore_hasWallBelow(self, i - 1, j) : true;
 }
 
 /// @brief Vérifie s'il y a un mur vertical à droite de [i,j].
@@ -255,7 +375,52 @@ INLINE bool QuoridorCore_hasWallRight(QuoridorCore *self, int i, int j)
 {
     assert(0 <= i && i < self->gridSize);
     assert(0 <= j && j < self->gridSize);
-    return (j < self->gridSize - 1) ? self->vWalls[i][j] : true;
+    if (j >= self->gridSize - 1) return true;
+
+    const int k = i * MAX_GRID_SIZE + j;
+    return QuoridorMask_test(self->vWalls, k) || (i > 0 && QuoridorMask_test(self->vWalls, k - MAX_GRID_SIZE));
+}
+
+/// @brief Vérifie s'il y a un mur vertical à gauche de [i,j].
+/// Le bord gauche est considéré comme un mur.
+/// @param self Instance du jeu Quoridor.
+/// @param i Ligne.
+/// @param j Colonne.
+/// @return true s'il y a un mur, false sinon.
+INLINE bool QuoridorCore_hasWallLeft(QuoridorCore *self, int i, int j)
+{
+    return (j > 0) ? QuoridorCore_hasWallRight(self, i, j - 1) : true;
+}
+
+/// @brief Renvoie l'indice du bit de validMoves associé à un déplacement relatif.
+/// @param di Décalage en ligne.
+/// @param dj Décalage en colonne.
+/// @return L'indice du bit, ou -1 si le décalage ne correspond à aucun déplacement possible.
+INLINE int QuoridorCore_getMoveIndex(int di, int dj)
+{
+    static const int8_t s_indices[5][5] = {
+        { -1, -1,  4, -1, -1 },
+        { -1,  8,  0,  9, -1 },
+        {  6,  2, -1,  3,  7 },
+        { -1, 10,  1, 11, -1 },
+        { -1, -1,  5, -1, -1 },
+    };
+    if (di < -2 || di > 2 || dj < -2 || dj > 2) return -1;
+    return s_indices[di + 2][dj + 2];
+}
+
+/// @brief Renvoie le déplacement relatif associé à un bit de validMoves.
+/// @param k Indice du bit (entre 0 et QUORIDOR_MOVE_COUNT - 1).
+/// @return Le décalage (en ligne et en colonne) correspondant.
+INLINE QuoridorPos QuoridorCore_getMoveOffset(int k)
+{
+    static const QuoridorPos s_offsets[QUORIDOR_MOVE_COUNT] = {
+        { -1,  0 }, { 1, 0 }, { 0, -1 }, {  0, 1 },
+        { -2,  0 }, { 2, 0 }, { 0, -2 }, {  0, 2 },
+        { -1, -1 }, { -1, 1 }, { 1, -1 }, { 1, 1 },
+    };
+    assert(0 <= k && k < QUORIDOR_MOVE_COUNT);
+    return s_offsets[k];
 }
 
 /// @brief Définit la validité du déplacement vers [i,j].
@@ -268,6 +433,35 @@ INLINE void QuoridorCore_setValidPosition(QuoridorCore *self, int i, int j, bool
 {
     if (0 <= i && i < self->gridSize && 0 <= j && j < self->gridSize)
     {
-        self->isValid[i][j] = isValid;
+        const QuoridorPos pos = self->positions[self->playerID];
+        const int k = QuoridorCore_getMoveIndex(i - pos.i, j - pos.j);
+        if (k < 0) return;
+
+        if (isValid) self->validMoves |= (uint16_t)(1 << k);
+        else self->validMoves &= (uint16_t)~(1 << k);
     }
 }
+
+/// @brief Renvoie la distance d'une case à la zone d'arrivée d'un joueur (sans tenir compte des pions).
+/// @param self Instance du jeu Quoridor.
+/// @param playerID Identifiant du joueur (0 ou 1).
+/// @param i Ligne.
+/// @param j Colonne.
+/// @return La distance, ou QUORIDOR_DISTANCE_INFINITE si la zone d'arrivée est inaccessible.
+INLINE int QuoridorCore_getDistance(QuoridorCore *self, int playerID, int i, int j)
+{
+    assert(0 <= i && i < self->gridSize);
+    assert(0 <= j && j < self->gridSize);
+    return self->distances[playerID][i * MAX_GRID_SIZE + j];
+}
+
+/// @brief Renvoie la longueur d'un plus court chemin entre la position d'un joueur et sa zone d'arrivée.
+/// Contrairement à QuoridorCore_getShortestPath(), aucun parcours n'est effectué.
+/// @param self Instance du jeu Quoridor.
+/// @param playerID Identifiant du joueur (0 ou 1).
+/// @return Le nombre de déplacements nécessaires (sans tenir compte des pions).
+INLINE int QuoridorCore_getPathLength(QuoridorCore *self, int playerID)
+{
+    const QuoridorPos pos = self->positions[playerID];
+    return QuoridorCore_getDistance(self, playerID, pos.i, pos.j);
+}
@@ -0,0 +1,137 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#ifndef _WIN32
+// ftruncate() n'est déclarée par les en-têtes système qu'avec les extensions POSIX.
+#  define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "core/quoridor_file_map.h"
+
+#ifdef _WIN32
+#  define WIN32_LEAN_AND_MEAN
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+QuoridorFileMap *QuoridorFileMap_create(const char *path, size_t size, bool writable)
+{
+    HANDLE file = CreateFileA(
+        path, writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+        writable ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL
+    );
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) fileSize.QuadPart = 0;
+    if (size == 0 && !writable) size = (size_t)fileSize.QuadPart;
+
+    // En écriture, une projection plus grande que le fichier l'agrandit.
+    HANDLE mapping = NULL;
+    if (size > 0 && (writable || (size_t)fileSize.QuadPart >= size))
+    {
+        const uint64_t mappingSize = writable ? (uint64_t)size : 0;
+        mapping = CreateFileMappingA(
+            file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY,
+            (DWORD)(mappingSize >> 32), (DWORD)mappingSize, NULL
+        );
+    }
+    void *data = mapping ? MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size) : NULL;
+    if (data == NULL)
+    {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return NULL;
+    }
+
+    QuoridorFileMap *self = (QuoridorFileMap *)calloc(1, sizeof(QuoridorFileMap));
+    AssertNew(self);
+
+    self->data = data;
+    self->size = size;
+    self->writable = writable;
+    self->m_file = file;
+    self->m_mapping = mapping;
+
+    return self;
+}
+
+void QuoridorFileMap_destroy(QuoridorFileMap *self)
+{
+    if (!self) return;
+
+    UnmapViewOfFile(self->data);
+    CloseHandle((HANDLE)self->m_mapping);
+    CloseHandle((HANDLE)self->m_file);
+    free(self);
+}
+
+void QuoridorFileMap_flush(QuoridorFileMap *self)
+{
+    assert(self && "The QuoridorFileMap must be created");
+    if (self->writable) FlushViewOfFile(self->data, 0);
+}
+
+#else
+
+QuoridorFileMap *QuoridorFileMap_create(const char *path, size_t size, bool writable)
+{
+    int fd = open(path, writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) st.st_size = 0;
+    if (size == 0 && !writable) size = (size_t)st.st_size;
+
+    bool valid = (size > 0);
+    if (valid && (size_t)st.st_size < size)
+    {
+        // Une projection au-delà de la fin du fichier provoquerait une erreur à l'accès.
+        valid = writable && ftruncate(fd, (off_t)size) == 0;
+    }
+
+    void *data = MAP_FAILED;
+    if (valid)
+    {
+        data = mmap(NULL, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    }
+
+    // La projection reste valide après la fermeture du descripteur.
+    close(fd);
+    if (data == MAP_FAILED) return NULL;
+
+    QuoridorFileMap *self = (QuoridorFileMap *)calloc(1, sizeof(QuoridorFileMap));
+    AssertNew(self);
+
+    self->data = data;
+    self->size = size;
+    self->writable = writable;
+
+    return self;
+}
+
+void QuoridorFileMap_destroy(QuoridorFileMap *self)
+{
+    if (!self) return;
+
+    munmap(self->data, self->size);
+    free(self);
+}
+
+void QuoridorFileMap_flush(QuoridorFileMap *self)
+{
+    assert(self && "The QuoridorFileMap must be created");
+    if (self->writable) msync(self->data, self->size, MS_ASYNC);
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+
+/// @brief Fichier projeté en mémoire (mmap sous Linux, MapViewOfFile sous Windows).
+/// Les pages sont chargées à la demande par le système et, en écriture,
+/// les modifications sont reportées dans le fichier sans appel explicite.
+typedef struct QuoridorFileMap
+{
+    /// @brief Contenu du fichier.
+    void *data;
+
+    /// @brief Nombre d'octets projetés.
+    size_t size;
+
+    /// @brief Indique si la projection est accessible en écriture.
+    bool writable;
+
+    /// @brief Fichier et projection (Windows uniquement : sous Linux, le descripteur est fermé dès la projection).
+    void *m_file;
+    void *m_mapping;
+} QuoridorFileMap;
+
+/// @brief Projette un fichier en mémoire.
+/// En écriture, le fichier est créé s'il n'existe pas et complété par des zéros
+/// s'il est plus petit que la taille demandée.
+/// @param path Chemin du fichier.
+/// @param size Nombre d'octets à projeter (0 : tout le fichier, en lecture seulement).
+/// @param writable true pour une projection en lecture et écriture, false pour une lecture seule.
+/// @return La projection créée, ou NULL si le fichier ne peut pas être ouvert ou projeté.
+QuoridorFileMap *QuoridorFileMap_create(const char *path, size_t size, bool writable);
+
+/// @brief Termine la projection et ferme le fichier.
+/// Les modifications sont écrites par le système.
+/// @param self Projection (peut être NULL).
+void QuoridorFileMap_destroy(QuoridorFileMap *self);
+
+/// @brief Demande l'écriture des modifications dans le fichier, sans attendre leur fin.
+/// @param self Projection.
+void QuoridorFileMap_flush(QuoridorFileMap *self);
@@ -0,0 +1,186 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include <stdint.h>
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
+/// @brief Masque de 128 bits représentant un ensemble de cases du plateau.
+/// La case [i,j] correspond au bit d'indice (i * MAX_GRID_SIZE + j),
+/// quelle que soit la taille de la grille utilisée.
+typedef struct QuoridorMask
+{
+    /// @brief Bits d'indices 0 à 63.
+    uint64_t lo;
+
+    /// @brief Bits d'indices 64 à 127.
+    uint64_t hi;
+} QuoridorMask;
+
+/// @brief Renvoie le masque vide.
+/// @return Un masque dont tous les bits valent 0.
+INLINE QuoridorMask QuoridorMask_zero()
+{
+    QuoridorMask mask = { 0 };
+    return mask;
+}
+
+/// @brief Renvoie un masque contenant un unique bit.
+/// @param k Indice du bit (entre 0 et 127).
+/// @return Le masque dont seul le bit k vaut 1.
+INLINE QuoridorMask QuoridorMask_bit(int k)
+{
+    assert(0 <= k && k < 128);
+    QuoridorMask mask = { 0 };
+    if (k < 64) mask.lo = (uint64_t)1 << k;
+    else mask.hi = (uint64_t)1 << (k - 64);
+    return mask;
+}
+
+/// @brief Indique si un bit d'un masque vaut 1.
+/// @param mask Le masque.
+/// @param k Indice du bit (entre 0 et 127).
+/// @return true si le bit k vaut 1, false sinon.
+INLINE bool QuoridorMask_test(QuoridorMask mask, int k)
+{
+    assert(0 <= k && k < 128);
+    return (k < 64) ? ((mask.lo >> k) & 1) : ((mask.hi >> (k - 64)) & 1);
+}
+
+/// @brief Met un bit d'un masque à 1.
+/// @param mask Adresse du masque à modifier.
+/// @param k Indice du bit (entre 0 et 127).
+INLINE void QuoridorMask_set(QuoridorMask *mask, int k)
+{
+    assert(0 <= k && k < 128);
+    if (k < 64) mask->lo |= (uint64_t)1 << k;
+    else mask->hi |= (uint64_t)1 << (k - 64);
+}
+
+/// @brief Met un bit d'un masque à 0.
+/// @param mask Adresse du masque à modifier.
+/// @param k Indice du bit (entre 0 et 127).
+INLINE void QuoridorMask_reset(QuoridorMask *mask, int k)
+{
+    assert(0 <= k && k < 128);
+    if (k < 64) mask->lo &= ~((uint64_t)1 << k);
+    else mask->hi &= ~((uint64_t)1 << (k - 64));
+}
+
+/// @brief Renvoie l'union de deux masques.
+INLINE QuoridorMask QuoridorMask_or(QuoridorMask a, QuoridorMask b)
+{
+    QuoridorMask mask = { a.lo | b.lo, a.hi | b.hi };
+    return mask;
+}
+
+/// @brief Renvoie l'intersection de deux masques.
+INLINE QuoridorMask QuoridorMask_and(QuoridorMask a, QuoridorMask b)
+{
+    QuoridorMask mask = { a.lo & b.lo, a.hi & b.hi };
+    return mask;
+}
+
+/// @brief Renvoie les bits de a qui ne sont pas dans b.
+INLINE QuoridorMask QuoridorMask_andNot(QuoridorMask a, QuoridorMask b)
+{
+    QuoridorMask mask = { a.lo & ~b.lo, a.hi & ~b.hi };
+    return mask;
+}
+
+/// @brief Renvoie la différence symétrique de deux masques.
+INLINE QuoridorMask QuoridorMask_xor(QuoridorMask a, QuoridorMask b)
+{
+    QuoridorMask mask = { a.lo ^ b.lo, a.hi ^ b.hi };
+    return mask;
+}
+
+/// @brief Décale un masque vers les indices croissants.
+/// @param a Le masque.
+/// @param n Nombre de bits du décalage (entre 1 et 63).
+/// @return Le masque décalé.
+INLINE QuoridorMask QuoridorMask_shl(QuoridorMask a, int n)
+{
+    assert(0 < n && n < 64);
+    QuoridorMask mask = { a.lo << n, (a.hi << n) | (a.lo >> (64 - n)) };
+    return mask;
+}
+
+/// @brief Décale un masque vers les indices décroissants.
+/// @param a Le masque.
+/// @param n Nombre de bits du décalage (entre 1 et 63).
+/// @return Le masque décalé.
+INLINE QuoridorMask QuoridorMask_shr(QuoridorMask a, int n)
+{
+    assert(0 < n && n < 64);
+    QuoridorMask mask = { (a.lo >> n) | (a.hi << (64 - n)), a.hi >> n };
+    return mask;
+}
+
+/// @brief Indique si un masque est vide.
+INLINE bool QuoridorMask_isZero(QuoridorMask a)
+{
+    return (a.lo | a.hi) == 0;
+}
+
+/// @brief Indique si deux masques sont égaux.
+INLINE bool QuoridorMask_equals(QuoridorMask a, QuoridorMask b)
+{
+    return (a.lo == b.lo) && (a.hi == b.hi);
+}
+
+/// @brief Renvoie l'indice du bit de poids faible d'un entier non nul.
+INLINE int UInt64_ctz(uint64_t x)
+{
+    assert(x != 0);
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return (int)index;
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+/// @brief Renvoie le nombre de bits à 1 d'un entier.
+INLINE int UInt64_popCount(uint64_t x)
+{
+#ifdef _MSC_VER
+    return (int)__popcnt64(x);
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+/// @brief Renvoie le nombre de bits à 1 d'un masque.
+INLINE int QuoridorMask_popCount(QuoridorMask a)
+{
+    return UInt64_popCount(a.lo) + UInt64_popCount(a.hi);
+}
+
+/// @brief Retire le bit de poids faible d'un masque non vide.
+/// Permet de parcourir les bits d'un masque :
+/// while (!QuoridorMask_isZero(mask)) { int k = QuoridorMask_popLSB(&mask); ... }
+/// @param mask Adresse du masque à modifier.
+/// @return L'indice du bit retiré.
+INLINE int QuoridorMask_popLSB(QuoridorMask *mask)
+{
+    assert(!QuoridorMask_isZero(*mask));
+    if (mask->lo)
+    {
+        int k = UInt64_ctz(mask->lo);
+        mask->lo &= mask->lo - 1;
+        return k;
+    }
+    int k = UInt64_ctz(mask->hi);
+    mask->hi &= mask->hi - 1;
+    return k + 64;
+}
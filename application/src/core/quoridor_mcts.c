@@ -0,0 +1,692 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/quoridor_mcts.h"
+#include "core/utils.h"
+#include <limits.h>
+
+/// @brief Constante d'exploration de la formule UCT (environ racine de 2).
+#define MCTS_EXPLORATION 1.4f
+
+/// @brief Nombre maximal de fils d'un noeud.
+#define MCTS_MAX_CHILDREN 128
+
+/// @brief Profondeur maximale d'une descente dans l'arbre.
+#define MCTS_MAX_DEPTH 256
+
+/// @brief Nombre maximal de threads d'une recherche.
+#define MCTS_MAX_THREADS 64
+
+/// @brief Nombre de simulations d'une recherche limitée seulement par le temps.
+/// Une marge évite le dépassement du compteur partagé.
+#define MCTS_UNLIMITED_PLAYOUTS (INT_MAX / 2)
+
+/// @brief Nombre de simulations entre deux lectures de l'horloge et du drapeau d'arrêt.
+#define MCTS_CLOCK_CHECK_INTERVAL 64
+
+/// @brief Probabilité de poser un mur pendant une simulation,
+/// selon que le joueur est en retard ou non dans la course vers l'arrivée.
+#define MCTS_WALL_PROBABILITY_BEHIND 0.5f
+#define MCTS_WALL_PROBABILITY_AHEAD 0.1f
+
+/// @brief Nombre de pas du chemin adverse considérés pour poser un mur pendant une simulation.
+#define MCTS_PLAYOUT_WALL_STEPS 3
+
+static uint64_t MCTS_rand(uint64_t *state)
+{
+    // xorshift64*
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/// @brief Nombre d'arbres créés depuis le début du programme.
+/// Il sert de graine aux arbres : rand() ne peut pas être appelée depuis plusieurs threads,
+/// et les arbres sont créés par les threads de l'IA.
+static SDL_AtomicInt s_treeCount;
+
+/// @brief Renvoie un entier pseudo-aléatoire compris entre 0 et n - 1.
+static int MCTS_randInt(uint64_t *state, int n)
+{
+    assert(n > 0);
+    return (int)((MCTS_rand(state) >> 33) % (uint64_t)n);
+}
+
+/// @brief Renvoie un nombre pseudo-aléatoire compris entre 0 et 1.
+static float MCTS_rand01(uint64_t *state)
+{
+    return (float)(MCTS_rand(state) >> 40) / (float)(1 << 24);
+}
+
+static uint16_t MCTSNode_packTurn(QuoridorTurn turn)
+{
+    return (uint16_t)(((turn.action & 3) << 8) | ((turn.i & 15) << 4) | (turn.j & 15));
+}
+
+static QuoridorTurn MCTSNode_getTurn(const MCTSNode *self)
+{
+    QuoridorTurn turn = { 0 };
+    turn.action = (QuoridorAction)((self->turn >> 8) & 3);
+    turn.i = (self->turn >> 4) & 15;
+    turn.j = self->turn & 15;
+    return turn;
+}
+
+MCTSTree *MCTSTree_create(int capacity)
+{
+    assert(capacity > 0);
+
+    MCTSTree *self = (MCTSTree *)calloc(1, sizeof(MCTSTree));
+    AssertNew(self);
+
+    self->nodes = (MCTSNode *)calloc(capacity, sizeof(MCTSNode));
+    AssertNew(self->nodes);
+    self->spare = (MCTSNode *)calloc(capacity, sizeof(MCTSNode));
+    AssertNew(self->spare);
+
+    self->capacity = capacity;
+    // splitmix64 : garantit un état non nul et bien mélangé.
+    uint64_t z = (uint64_t)(Uint32)SDL_AddAtomicInt(&s_treeCount, 1) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    self->randState = (z ^ (z >> 31)) | 1;
+    MCTSTree_clear(self);
+
+    return self;
+}
+
+void MCTSTree_destroy(MCTSTree *self)
+{
+    if (!self) return;
+    free(self->nodes);
+    free(self->spare);
+    free(self);
+}
+
+void MCTSTree_clear(MCTSTree *self)
+{
+    assert(self && "The MCTSTree must be created");
+    SDL_SetAtomicInt(&self->nodeCount, 0);
+    self->root = -1;
+}
+
+/// @brief Joue un tour sur un plateau (sans vérification ni sauvegarde).
+static void MCTS_applyTurn(QuoridorCore *board, QuoridorTurn turn)
+{
+    switch (turn.action)
+    {
+    case QUORIDOR_MOVE_TO:
+        QuoridorCore_moveTo(board, turn.i, turn.j);
+        break;
+    case QUORIDOR_PLAY_HORIZONTAL_WALL:
+        QuoridorCore_playWall(board, WALL_TYPE_HORIZONTAL, turn.i, turn.j);
+        break;
+    case QUORIDOR_PLAY_VERTICAL_WALL:
+        QuoridorCore_playWall(board, WALL_TYPE_VERTICAL, turn.i, turn.j);
+        break;
+    default:
+        break;
+    }
+}
+
+/// @brief Ajoute aux masques les emplacements de murs qui bloquent le pas de a vers b (cases voisines).
+static void MCTS_addBlockingWalls(QuoridorCore *board, QuoridorPos a, QuoridorPos b, QuoridorMask *hMask, QuoridorMask *vMask)
+{
+    const int last = board->gridSize - 2;
+    if (a.i != b.i)
+    {
+        // Un mur horizontal en [i,j] bloque les pas verticaux depuis [i,j] et [i,j+1].
+        const int i = Int_min(a.i, b.i);
+        if (a.j <= last) QuoridorMask_set(hMask, i * MAX_GRID_SIZE + a.j);
+        if (a.j >= 1) QuoridorMask_set(hMask, i * MAX_GRID_SIZE + a.j - 1);
+    }
+    else
+    {
+        // Un mur vertical en [i,j] bloque les pas horizontaux depuis [i,j] et [i+1,j].
+        const int j = Int_min(a.j, b.j);
+        if (a.i <= last) QuoridorMask_set(vMask, a.i * MAX_GRID_SIZE + j);
+        if (a.i >= 1) QuoridorMask_set(vMask, (a.i - 1) * MAX_GRID_SIZE + j);
+    }
+}
+
+/// @brief Ajoute aux masques les emplacements de murs qui coupent un plus court chemin d'un joueur.
+/// Le chemin est obtenu en descendant le champ de distances du joueur.
+/// @param board Plateau.
+/// @param playerID Identifiant du joueur.
+/// @param maxSteps Nombre maximal de pas du chemin considérés.
+/// @param hMask Masque des murs horizontaux.
+/// @param vMask Masque des murs verticaux.
+static void MCTS_addPathWalls(QuoridorCore *board, int playerID, int maxSteps, QuoridorMask *hMask, QuoridorMask *vMask)
+{
+    QuoridorPos pos = board->positions[playerID];
+    int dist = QuoridorCore_getDistance(board, playerID, pos.i, pos.j);
+    if (dist == QUORIDOR_DISTANCE_INFINITE)
+        return;
+
+    for (int step = 0; step < maxSteps && dist > 0; step++)
+    {
+        QuoridorPos next = pos;
+        if (!QuoridorCore_hasWallBelow(board, pos.i, pos.j)
+            && QuoridorCore_getDistance(board, playerID, pos.i + 1, pos.j) == dist - 1)
+            next.i++;
+        else if (!QuoridorCore_hasWallAbove(board, pos.i, pos.j)
+            && QuoridorCore_getDistance(board, playerID, pos.i - 1, pos.j) == dist - 1)
+            next.i--;
+        else if (!QuoridorCore_hasWallRight(board, pos.i, pos.j)
+            && QuoridorCore_getDistance(board, playerID, pos.i, pos.j + 1) == dist - 1)
+            next.j++;
+        else if (!QuoridorCore_hasWallLeft(board, pos.i, pos.j)
+            && QuoridorCore_getDistance(board, playerID, pos.i, pos.j - 1) == dist - 1)
+            next.j--;
+        else
+            break;
+
+        MCTS_addBlockingWalls(board, pos, next, hMask, vMask);
+        pos = next;
+        dist--;
+    }
+}
+
+/// @brief Renvoie le déplacement qui rapproche le plus le joueur courant de son arrivée.
+/// Les égalités sont départagées au hasard.
+static QuoridorTurn MCTS_getGreedyMove(uint64_t *randState, QuoridorCore *board)
+{
+    const int playerID = board->playerID;
+    const QuoridorPos pos = board->positions[playerID];
+
+    QuoridorTurn turn = { 0 };
+    int bestDist = INT_MAX;
+    int tieCount = 0;
+
+    for (int k = 0; k < QUORIDOR_MOVE_COUNT; k++)
+    {
+        if (((board->validMoves >> k) & 1) == 0)
+            continue;
+
+        const QuoridorPos offset = QuoridorCore_getMoveOffset(k);
+        const int i = pos.i + offset.i;
+        const int j = pos.j + offset.j;
+        const int dist = QuoridorCore_getDistance(board, playerID, i, j);
+
+        if (dist < bestDist)
+        {
+            bestDist = dist;
+            tieCount = 1;
+        }
+        else if (dist > bestDist || MCTS_randInt(randState, ++tieCount) != 0)
+        {
+            continue;
+        }
+
+        turn.action = QUORIDOR_MOVE_TO;
+        turn.i = i;
+        turn.j = j;
+    }
+    return turn;
+}
+
+/// @brief Tente de poser un mur sur les premiers pas du chemin de l'adversaire.
+/// @return true si un mur a été posé, false sinon.
+static bool MCTS_playPlayoutWall(uint64_t *randState, QuoridorCore *board)
+{
+    QuoridorMask hMask = QuoridorMask_zero();
+    QuoridorMask vMask = QuoridorMask_zero();
+    MCTS_addPathWalls(board, board->playerID ^ 1, MCTS_PLAYOUT_WALL_STEPS, &hMask, &vMask);
+
+    QuoridorTurn candidates[4 * MCTS_PLAYOUT_WALL_STEPS];
+    int count = 0;
+    while (!QuoridorMask_isZero(hMask) && count < 4 * MCTS_PLAYOUT_WALL_STEPS)
+    {
+        const int k = QuoridorMask_popLSB(&hMask);
+        candidates[count++] = (QuoridorTurn){ QUORIDOR_PLAY_HORIZONTAL_WALL, k / MAX_GRID_SIZE, k % MAX_GRID_SIZE };
+    }
+    while (!QuoridorMask_isZero(vMask) && count < 4 * MCTS_PLAYOUT_WALL_STEPS)
+    {
+        const int k = QuoridorMask_popLSB(&vMask);
+        candidates[count++] = (QuoridorTurn){ QUORIDOR_PLAY_VERTICAL_WALL, k / MAX_GRID_SIZE, k % MAX_GRID_SIZE };
+    }
+    if (count == 0)
+        return false;
+
+    const int start = MCTS_randInt(randState, count);
+    for (int n = 0; n < count; n++)
+    {
+        const QuoridorTurn turn = candidates[(start + n) % count];
+        const WallType type = (turn.action == QUORIDOR_PLAY_HORIZONTAL_WALL) ? WALL_TYPE_HORIZONTAL : WALL_TYPE_VERTICAL;
+        if (QuoridorCore_canPlayWall(board, type, turn.i, turn.j))
+        {
+            QuoridorCore_playWall(board, type, turn.i, turn.j);
+            return true;
+        }
+    }
+    return false;
+}
+
+/// @brief Termine une partie avec une politique gloutonne :
+/// chaque joueur avance sur un plus court chemin et pose parfois un mur sur le chemin adverse.
+/// @param randState État du générateur pseudo-aléatoire du thread.
+/// @param board Plateau de la simulation (modifié).
+/// @return L'identifiant du vainqueur, ou -1 si la simulation n'a pas abouti.
+static int MCTS_playout(uint64_t *randState, QuoridorCore *board)
+{
+    const int maxPlies = 4 * board->gridSize * board->gridSize;
+
+    for (int ply = 0; ply < maxPlies && board->state == QUORIDOR_STATE_IN_PROGRESS; ply++)
+    {
+        const int playerID = board->playerID;
+        const int myDist = QuoridorCore_getPathLength(board, playerID);
+        const int otherDist = QuoridorCore_getPathLength(board, playerID ^ 1);
+
+        // Sans mur restant, la partie est une course : le joueur qui doit jouer gagne les égalités.
+        if (board->wallCounts[0] == 0 && board->wallCounts[1] == 0)
+            return (myDist <= otherDist) ? playerID : playerID ^ 1;
+
+        if (board->wallCounts[playerID] > 0)
+        {
+            const float probability = (myDist > otherDist) ? MCTS_WALL_PROBABILITY_BEHIND : MCTS_WALL_PROBABILITY_AHEAD;
+            if (MCTS_rand01(randState) < probability && MCTS_playPlayoutWall(randState, board))
+                continue;
+        }
+
+        const QuoridorTurn turn = MCTS_getGreedyMove(randState, board);
+        if (turn.action == QUORIDOR_ACTION_UNDEFINED)
+            return -1;
+        QuoridorCore_moveTo(board, turn.i, turn.j);
+    }
+
+    switch (board->state)
+    {
+    case QUORIDOR_STATE_P0_WON: return 0;
+    case QUORIDOR_STATE_P1_WON: return 1;
+    default: return -1;
+    }
+}
+
+/// @brief Réserve des noeuds contigus dans l'arbre.
+/// @return L'indice du premier noeud, ou -1 si l'arbre est plein.
+static int MCTSTree_allocate(MCTSTree *self, int count)
+{
+    while (true)
+    {
+        const int first = SDL_GetAtomicInt(&self->nodeCount);
+        if (first + count > self->capacity)
+            return -1;
+        if (SDL_CompareAndSwapAtomicInt(&self->nodeCount, first, first + count))
+            return first;
+    }
+}
+
+/// @brief Développe un noeud : crée un fils par déplacement et par mur coupant le chemin de l'adversaire.
+/// Un seul thread développe un noeud donné ; les autres poursuivent sans attendre.
+/// @return true si le noeud a été développé par ce thread, false sinon.
+static bool MCTSTree_expand(MCTSTree *self, int nodeIndex, QuoridorCore *board)
+{
+    MCTSNode *node = &self->nodes[nodeIndex];
+    if (SDL_GetAtomicInt(&self->nodeCount) + MCTS_MAX_CHILDREN > self->capacity)
+        return false;
+    if (!SDL_CompareAndSwapAtomicInt(&node->firstChild, MCTS_NOT_EXPANDED, MCTS_EXPANDING))
+        return false;
+
+    QuoridorTurn turns[MCTS_MAX_CHILDREN];
+    int dists[QUORIDOR_MOVE_COUNT];
+    int count = 0;
+
+    // Déplacements, du plus proche au plus éloigné de l'arrivée.
+    const int playerID = board->playerID;
+    const QuoridorPos pos = board->positions[playerID];
+    for (int k = 0; k < QUORIDOR_MOVE_COUNT; k++)
+    {
+        if (((board->validMoves >> k) & 1) == 0)
+            continue;
+
+        const QuoridorPos offset = QuoridorCore_getMoveOffset(k);
+        const int dist = QuoridorCore_getDistance(board, playerID, pos.i + offset.i, pos.j + offset.j);
+        int n = count++;
+        while (n > 0 && dists[n - 1] > dist)
+        {
+            turns[n] = turns[n - 1];
+            dists[n] = dists[n - 1];
+            n--;
+        }
+        turns[n] = (QuoridorTurn){ QUORIDOR_MOVE_TO, pos.i + offset.i, pos.j + offset.j };
+        dists[n] = dist;
+    }
+
+    // Murs légaux qui coupent un plus court chemin de l'adversaire.
+    if (board->wallCounts[playerID] > 0)
+    {
+        QuoridorMask hPath = QuoridorMask_zero();
+        QuoridorMask vPath = QuoridorMask_zero();
+        MCTS_addPathWalls(board, playerID ^ 1, MAX_PATH_LEN, &hPath, &vPath);
+
+        QuoridorMask hLegal, vLegal;
+        QuoridorCore_generateLegalWalls(board, &hLegal, &vLegal);
+        hLegal = QuoridorMask_and(hLegal, hPath);
+        vLegal = QuoridorMask_and(vLegal, vPath);
+
+        while (!QuoridorMask_isZero(hLegal) && count < MCTS_MAX_CHILDREN)
+        {
+            const int k = QuoridorMask_popLSB(&hLegal);
+            turns[count++] = (QuoridorTurn){ QUORIDOR_PLAY_HORIZONTAL_WALL, k / MAX_GRID_SIZE, k % MAX_GRID_SIZE };
+        }
+        while (!QuoridorMask_isZero(vLegal) && count < MCTS_MAX_CHILDREN)
+        {
+            const int k = QuoridorMask_popLSB(&vLegal);
+            turns[count++] = (QuoridorTurn){ QUORIDOR_PLAY_VERTICAL_WALL, k / MAX_GRID_SIZE, k % MAX_GRID_SIZE };
+        }
+    }
+
+    const int first = (count > 0) ? MCTSTree_allocate(self, count) : -1;
+    if (first < 0)
+    {
+        SDL_SetAtomicInt(&node->firstChild, MCTS_NOT_EXPANDED);
+        return false;
+    }
+
+    for (int n = 0; n < count; n++)
+    {
+        // La clé d'un fils est renseignée lors de sa première visite.
+        MCTSNode *child = &self->nodes[first + n];
+        memset(child, 0, sizeof(MCTSNode));
+        child->parent = nodeIndex;
+        SDL_SetAtomicInt(&child->firstChild, MCTS_NOT_EXPANDED);
+        child->turn = MCTSNode_packTurn(turns[n]);
+    }
+
+    // Publication : les autres threads ne lisent childCount qu'après avoir vu un indice valide.
+    node->childCount = (uint16_t)count;
+    SDL_SetAtomicInt(&node->firstChild, first);
+    return true;
+}
+
+/// @brief Choisit le fils d'un noeud développé selon la formule UCT.
+/// Les fils jamais visités sont choisis en premier, dans l'ordre de création.
+static int MCTSTree_selectChild(MCTSTree *self, int nodeIndex, int firstChild)
+{
+    MCTSNode *node = &self->nodes[nodeIndex];
+    const float logVisits = logf((float)Int_max(SDL_GetAtomicInt(&node->visitCount), 1));
+
+    int best = firstChild;
+    float bestScore = -INFINITY;
+    for (int n = 0; n < node->childCount; n++)
+    {
+        const int childIndex = firstChild + n;
+        MCTSNode *child = &self->nodes[childIndex];
+        const int visitCount = SDL_GetAtomicInt(&child->visitCount);
+        if (visitCount == 0)
+            return childIndex;
+
+        const float visits = (float)visitCount;
+        const float score = (float)SDL_GetAtomicInt(&child->winCount) / (2.0f * visits)
+            + MCTS_EXPLORATION * sqrtf(logVisits / visits);
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best = childIndex;
+        }
+    }
+    return best;
+}
+
+/// @brief Descend vers un fils : applique son tour et compte la visite (perte virtuelle).
+static void MCTSTree_visit(MCTSTree *self, int nodeIndex, QuoridorCore *board)
+{
+    MCTSNode *node = &self->nodes[nodeIndex];
+    MCTS_applyTurn(board, MCTSNode_getTurn(node));
+
+    // Seul le premier visiteur renseigne la clé (lue uniquement entre deux recherches).
+    if (SDL_AddAtomicInt(&node->visitCount, 1) == 0)
+        node->key = board->hashKey;
+}
+
+/// @brief Effectue une itération : sélection, développement, simulation et rétropropagation.
+static void MCTSTree_iterate(MCTSTree *self, const QuoridorCore *core, uint64_t *randState)
+{
+    QuoridorCore board = *core;
+
+    // movers[d] : joueur ayant joué le tour du noeud path[d].
+    int path[MCTS_MAX_DEPTH];
+    int movers[MCTS_MAX_DEPTH];
+    int depth = 0;
+
+    int nodeIndex = self->root;
+    path[depth] = nodeIndex;
+    movers[depth++] = board.playerID ^ 1;
+    SDL_AddAtomicInt(&self->nodes[nodeIndex].visitCount, 1);
+
+    // Sélection
+    int firstChild;
+    while ((firstChild = SDL_GetAtomicInt(&self->nodes[nodeIndex].firstChild)) >= 0
+        && board.state == QUORIDOR_STATE_IN_PROGRESS && depth < MCTS_MAX_DEPTH)
+    {
+        nodeIndex = MCTSTree_selectChild(self, nodeIndex, firstChild);
+        movers[depth] = board.playerID;
+        path[depth++] = nodeIndex;
+        MCTSTree_visit(self, nodeIndex, &board);
+    }
+
+    // Développement d'un noeud déjà visité, puis simulation depuis son premier fils.
+    if (board.state == QUORIDOR_STATE_IN_PROGRESS && depth < MCTS_MAX_DEPTH
+        && (SDL_GetAtomicInt(&self->nodes[nodeIndex].visitCount) > 1 || nodeIndex == self->root)
+        && MCTSTree_expand(self, nodeIndex, &board))
+    {
+        nodeIndex = SDL_GetAtomicInt(&self->nodes[nodeIndex].firstChild);
+        movers[depth] = board.playerID;
+        path[depth++] = nodeIndex;
+        MCTSTree_visit(self, nodeIndex, &board);
+    }
+
+    const int winner = MCTS_playout(randState, &board);
+
+    // Rétropropagation (les visites ont été comptées lors de la descente).
+    for (int d = 0; d < depth; d++)
+    {
+        const int result = (winner < 0) ? 1 : ((winner == movers[d]) ? 2 : 0);
+        if (result > 0)
+            SDL_AddAtomicInt(&self->nodes[path[d]].winCount, result);
+    }
+}
+
+/// @brief Conserve uniquement le sous-arbre d'un noeud, recopié au début du second tableau.
+static void MCTSTree_reroot(MCTSTree *self, int nodeIndex)
+{
+    MCTSNode *dst = self->spare;
+    int count = 0;
+
+    dst[count] = self->nodes[nodeIndex];
+    dst[count++].parent = -1;
+
+    // Parcours en largeur : les fils d'un noeud restent contigus.
+    for (int n = 0; n < count; n++)
+    {
+        MCTSNode *node = &dst[n];
+        const int first = SDL_GetAtomicInt(&node->firstChild);
+        if (first < 0)
+            continue;
+
+        SDL_SetAtomicInt(&node->firstChild, count);
+        for (int c = 0; c < node->childCount; c++)
+        {
+            dst[count] = self->nodes[first + c];
+            dst[count++].parent = n;
+        }
+    }
+
+    self->spare = self->nodes;
+    self->nodes = dst;
+    SDL_SetAtomicInt(&self->nodeCount, count);
+    self->root = 0;
+}
+
+/// @brief Recherche parmi les fils d'un noeud celui qui correspond à une position déjà visitée.
+/// @return L'indice du fils, ou -1 s'il n'existe pas.
+static int MCTSTree_findChild(MCTSTree *self, int nodeIndex, uint64_t key)
+{
+    MCTSNode *node = &self->nodes[nodeIndex];
+    const int first = SDL_GetAtomicInt(&node->firstChild);
+    for (int c = 0; first >= 0 && c < node->childCount; c++)
+    {
+        MCTSNode *child = &self->nodes[first + c];
+        if (SDL_GetAtomicInt(&child->visitCount) > 0 && child->key == key)
+            return first + c;
+    }
+    return -1;
+}
+
+/// @brief Place la racine de l'arbre sur une position.
+/// Le sous-arbre de la position est réutilisé s'il se trouve à au plus deux tours de l'ancienne racine.
+static void MCTSTree_setRoot(MCTSTree *self, const QuoridorCore *core)
+{
+    int found = -1;
+    if (self->root >= 0)
+    {
+        MCTSNode *root = &self->nodes[self->root];
+        if (root->key == core->hashKey)
+            found = self->root;
+        if (found < 0)
+            found = MCTSTree_findChild(self, self->root, core->hashKey);
+
+        const int first = SDL_GetAtomicInt(&root->firstChild);
+        for (int c = 0; found < 0 && first >= 0 && c < root->childCount; c++)
+        {
+            found = MCTSTree_findChild(self, first + c, core->hashKey);
+        }
+    }
+
+    if (found >= 0)
+    {
+        MCTSTree_reroot(self, found);
+        return;
+    }
+
+    MCTSTree_clear(self);
+    MCTSNode *root = &self->nodes[0];
+    memset(root, 0, sizeof(MCTSNode));
+    root->key = core->hashKey;
+    root->parent = -1;
+    SDL_SetAtomicInt(&root->firstChild, MCTS_NOT_EXPANDED);
+    self->root = 0;
+    SDL_SetAtomicInt(&self->nodeCount, 1);
+}
+
+/// @brief Données partagées par les threads d'une recherche.
+typedef struct MCTSSearch
+{
+    MCTSTree *tree;
+    const QuoridorCore *root;
+    const AISearchParams *params;
+
+    /// @brief Instant (en ms) de fin de la recherche, ou 0 s'il n'y a pas de limite de temps.
+    Uint64 deadline;
+
+    /// @brief Nombre maximal de simulations.
+    int maxPlayouts;
+
+    /// @brief Nombre de simulations réservées par les threads.
+    SDL_AtomicInt playoutCount;
+
+    /// @brief Vaut 1 lorsque l'un des threads a constaté la fin de la recherche.
+    SDL_AtomicInt stopped;
+} MCTSSearch;
+
+/// @brief Données propres à un thread de la recherche.
+typedef struct MCTSWorker
+{
+    MCTSSearch *search;
+    uint64_t randState;
+} MCTSWorker;
+
+static int MCTSWorker_run(void *data)
+{
+    MCTSWorker *worker = (MCTSWorker *)data;
+    MCTSSearch *search = worker->search;
+    const AISearchParams *params = search->params;
+
+    // Les simulations sont réservées par blocs pour limiter les accès au compteur partagé.
+    while (!SDL_GetAtomicInt(&search->stopped))
+    {
+        const int first = SDL_AddAtomicInt(&search->playoutCount, MCTS_CLOCK_CHECK_INTERVAL);
+        const int last = Int_min(first + MCTS_CLOCK_CHECK_INTERVAL, search->maxPlayouts);
+        for (int n = first; n < last; n++)
+        {
+            MCTSTree_iterate(search->tree, search->root, &worker->randState);
+        }
+
+        if (last >= search->maxPlayouts
+            || (search->deadline && SDL_GetTicks() >= search->deadline)
+            || (params->stopFlag && SDL_GetAtomicInt(params->stopFlag)))
+        {
+            SDL_SetAtomicInt(&search->stopped, 1);
+        }
+    }
+    return 0;
+}
+
+QuoridorTurn MCTSTree_search(MCTSTree *self, QuoridorCore *core, const AISearchParams *params)
+{
+    assert(self && "The MCTSTree must be created");
+
+    QuoridorTurn bestTurn = { 0 };
+    if (core->state != QUORIDOR_STATE_IN_PROGRESS)
+        return bestTurn;
+
+    MCTSTree_setRoot(self, core);
+
+    MCTSSearch search = { 0 };
+    search.tree = self;
+    search.root = core;
+    search.params = params;
+    search.deadline = (params->budgetMS > 0) ? SDL_GetTicks() + params->budgetMS : 0;
+    search.maxPlayouts = params->playoutCount;
+    if (search.maxPlayouts <= 0)
+        search.maxPlayouts = (params->budgetMS > 0) ? MCTS_UNLIMITED_PLAYOUTS : MCTS_DEFAULT_PLAYOUT_COUNT;
+    SDL_SetAtomicInt(&search.playoutCount, 0);
+    SDL_SetAtomicInt(&search.stopped, 0);
+
+    // Le thread appelant participe à la recherche ; chaque thread a son propre générateur.
+    const int threadCount = Int_clamp(params->threadCount, 1, MCTS_MAX_THREADS);
+    MCTSWorker workers[MCTS_MAX_THREADS];
+    SDL_Thread *threads[MCTS_MAX_THREADS] = { 0 };
+    for (int i = 0; i < threadCount; i++)
+    {
+        workers[i].search = &search;
+        workers[i].randState = (MCTS_rand(&self->randState) ^ params->seed) | 1;
+    }
+    for (int i = 1; i < threadCount; i++)
+    {
+        threads[i] = SDL_CreateThread(MCTSWorker_run, "MCTSWorker", &workers[i]);
+        AssertNew(threads[i]);
+    }
+    MCTSWorker_run(&workers[0]);
+    for (int i = 1; i < threadCount; i++)
+    {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    // Le fils le plus visité est le plus fiable.
+    MCTSNode *root = &self->nodes[self->root];
+    const int first = SDL_GetAtomicInt(&root->firstChild);
+    int bestVisits = -1;
+    for (int c = 0; first >= 0 && c < root->childCount; c++)
+    {
+        MCTSNode *child = &self->nodes[first + c];
+        const int visitCount = SDL_GetAtomicInt(&child->visitCount);
+        if (visitCount > bestVisits)
+        {
+            bestVisits = visitCount;
+            bestTurn = MCTSNode_getTurn(child);
+        }
+    }
+
+    // L'arbre est plein et la racine n'a pas pu être développée.
+    if (bestTurn.action == QUORIDOR_ACTION_UNDEFINED)
+        bestTurn = MCTS_getGreedyMove(&self->randState, core);
+
+    return bestTurn;
+}
@@ -0,0 +1,104 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_ai.h"
+
+/// @brief Nombre de noeuds réservés par défaut pour un arbre MCTS.
+#define MCTS_DEFAULT_CAPACITY (1 << 18)
+
+/// @brief Nombre de simulations d'une recherche sans budget de temps ni nombre de simulations.
+#define MCTS_DEFAULT_PLAYOUT_COUNT 20000
+
+/// @brief Valeurs particulières de MCTSNode.firstChild.
+#define MCTS_NOT_EXPANDED (-1)
+#define MCTS_EXPANDING (-2)
+
+/// @brief Noeud de l'arbre MCTS (32 octets).
+/// Un noeud correspond à la position obtenue après avoir joué son tour depuis son parent.
+/// Les compteurs et l'indice du premier fils sont atomiques : plusieurs threads parcourent l'arbre en même temps.
+typedef struct MCTSNode
+{
+    /// @brief Clé de Zobrist de la position du noeud.
+    uint64_t key;
+
+    /// @brief Nombre de simulations passées par le noeud, y compris celles en cours.
+    /// Une simulation en cours compte comme une défaite (perte virtuelle) :
+    /// les autres threads sont incités à explorer d'autres branches.
+    SDL_AtomicInt visitCount;
+
+    /// @brief Somme des résultats des simulations terminées, en demi-points,
+    /// du point de vue du joueur qui a joué le tour du noeud (2 : victoire, 1 : nulle, 0 : défaite).
+    SDL_AtomicInt winCount;
+
+    /// @brief Indice du parent (-1 pour la racine).
+    int parent;
+
+    /// @brief Indice du premier fils (les fils sont contigus).
+    /// Vaut MCTS_NOT_EXPANDED si le noeud n'est pas développé et MCTS_EXPANDING pendant son développement.
+    /// Le thread qui fait passer cette valeur de MCTS_NOT_EXPANDED à MCTS_EXPANDING développe le noeud ;
+    /// childCount est écrit avant la publication de l'indice.
+    SDL_AtomicInt firstChild;
+
+    /// @brief Nombre de fils.
+    uint16_t childCount;
+
+    /// @brief Tour menant au noeud, compacté (action sur 2 bits, ligne et colonne sur 4 bits).
+    uint16_t turn;
+} MCTSNode;
+
+/// @brief Arbre de recherche Monte-Carlo.
+/// Les noeuds sont alloués dans un tableau de taille fixe.
+/// D'une recherche à l'autre, le sous-arbre de la nouvelle position est conservé
+/// et recopié au début d'un second tableau, ce qui libère les autres noeuds.
+typedef struct MCTSTree
+{
+    /// @brief Tableau des noeuds.
+    MCTSNode *nodes;
+
+    /// @brief Tableau de même taille utilisé pour compacter l'arbre.
+    MCTSNode *spare;
+
+    /// @brief Nombre de noeuds du tableau.
+    int capacity;
+
+    /// @brief Nombre de noeuds utilisés (alloués de façon atomique).
+    SDL_AtomicInt nodeCount;
+
+    /// @brief Indice de la racine (-1 si l'arbre est vide).
+    int root;
+
+    /// @brief État du générateur pseudo-aléatoire, d'où sont tirées les graines des threads.
+    uint64_t randState;
+} MCTSTree;
+
+/// @brief Crée un arbre de recherche Monte-Carlo vide.
+/// @param capacity Nombre maximal de noeuds.
+/// @return Un pointeur vers l'arbre créé.
+MCTSTree *MCTSTree_create(int capacity);
+
+/// @brief Détruit un arbre de recherche Monte-Carlo.
+/// @param self Arbre à détruire.
+void MCTSTree_destroy(MCTSTree *self);
+
+/// @brief Vide un arbre de recherche Monte-Carlo.
+/// @param self Arbre.
+void MCTSTree_clear(MCTSTree *self);
+
+/// @brief Calcule le coup du joueur courant par recherche arborescente Monte-Carlo (UCT).
+/// Avec plusieurs threads (params->threadCount), tous parcourent le même arbre.
+/// Si la position est atteinte depuis la racine de la recherche précédente en au plus deux tours,
+/// le sous-arbre correspondant est réutilisé.
+/// La recherche s'arrête à la fin du budget de temps, après le nombre de simulations demandé
+/// ou lorsque le drapeau d'arrêt est levé. Le coup le plus visité de la racine est renvoyé.
+/// @param self Arbre.
+/// @param core Position à analyser (non modifiée).
+/// @param params Paramètres de la recherche (budgetMS, playoutCount, threadCount, stopFlag et seed sont utilisés).
+/// @return Le tour choisi.
+QuoridorTurn MCTSTree_search(MCTSTree *self, QuoridorCore *core, const AISearchParams *params);
@@ -0,0 +1,305 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/quoridor_path.h"
+#include "core/utils.h"
+#include <limits.h>
+
+/// @brief Moteur utilisé par QuoridorCore_getShortestPath() pour chaque taille de grille.
+static QuoridorPathEngine s_pathEngines[MAX_GRID_SIZE + 1] = { 0 };
+
+void QuoridorCore_setPathEngine(int gridSize, QuoridorPathEngine engine)
+{
+    assert(0 <= engine && engine < QUORIDOR_PATH_ENGINE_COUNT);
+    assert(0 <= gridSize && gridSize <= MAX_GRID_SIZE);
+
+    if (gridSize > 0)
+    {
+        s_pathEngines[gridSize] = engine;
+        return;
+    }
+    for (int i = 0; i <= MAX_GRID_SIZE; i++)
+        s_pathEngines[i] = engine;
+}
+
+QuoridorPathEngine QuoridorCore_getPathEngine(int gridSize)
+{
+    assert(0 < gridSize && gridSize <= MAX_GRID_SIZE);
+    return s_pathEngines[gridSize];
+}
+
+const char *QuoridorPathEngine_getName(QuoridorPathEngine engine)
+{
+    switch (engine)
+    {
+    case QUORIDOR_PATH_DISTANCE_FIELD: return "distance field";
+    case QUORIDOR_PATH_BFS: return "BFS";
+    case QUORIDOR_PATH_BUCKET_QUEUE: return "bucket queue";
+    case QUORIDOR_PATH_ASTAR: return "A*";
+    default: return "unknown";
+    }
+}
+
+static void QuoridorCore_getShortestPathDescent(QuoridorCore *self, int playerID, QuoridorPos *path, int *size)
+{
+    // Le champ de distances (calculé depuis la zone d'arrivée) ne dépend que des murs :
+    // le chemin est reconstruit par descente, en passant à chaque pas sur une case voisine plus proche de l'arrivée.
+    // Les voisines sont testées en commençant par la direction de l'arrivée.
+    const int dj = (playerID == 0) ? 1 : -1;
+    const QuoridorPos directions[4] = { { 0, dj }, { -1, 0 }, { 1, 0 }, { 0, -dj } };
+
+    QuoridorPos curr = self->positions[playerID];
+    int dist = QuoridorCore_getDistance(self, playerID, curr.i, curr.j);
+    assert(dist != QUORIDOR_DISTANCE_INFINITE);
+
+    *size = dist + 1;
+    path[dist] = curr;
+
+    while (dist > 0)
+    {
+        for (int d = 0; d < 4; d++)
+        {
+            const int i = curr.i;
+            const int j = curr.j;
+            bool blocked;
+            if (directions[d].i < 0) blocked = QuoridorCore_hasWallAbove(self, i, j);
+            else if (directions[d].i > 0) blocked = QuoridorCore_hasWallBelow(self, i, j);
+            else if (directions[d].j < 0) blocked = QuoridorCore_hasWallLeft(self, i, j);
+            else blocked = QuoridorCore_hasWallRight(self, i, j);
+
+            if (blocked) continue;
+
+            const int nextI = i + directions[d].i;
+            const int nextJ = j + directions[d].j;
+            if (QuoridorCore_getDistance(self, playerID, nextI, nextJ) == dist - 1)
+            {
+                curr.i = nextI;
+                curr.j = nextJ;
+                break;
+            }
+        }
+
+        dist--;
+        path[dist] = curr;
+    }
+}
+
+static void QuoridorCore_getShortestPathBFS(QuoridorCore *self, int playerID, QuoridorPos *path, int *size)
+{
+    int gridSize = self->gridSize;
+
+    int targetJ = (playerID == 0) ? gridSize - 1 : 0;
+
+    bool explored[MAX_GRID_SIZE][MAX_GRID_SIZE] = {0};
+
+    QuoridorPos pred[MAX_GRID_SIZE][MAX_GRID_SIZE];
+    memset(pred, -1, sizeof(pred));
+
+    unsigned int dist[MAX_GRID_SIZE][MAX_GRID_SIZE];
+    memset(dist, UINT_MAX, sizeof(dist));
+
+    QuoridorPos file[MAX_GRID_SIZE * MAX_GRID_SIZE];
+    memset(file, -1, sizeof(file));
+    int readCursor = 0;
+    int writeCursor = 0;
+    file[writeCursor].i = self->positions[playerID].i;
+    file[writeCursor++].j = self->positions[playerID].j;
+
+    int i = file[readCursor].i, j = file[readCursor].j;
+    dist[i][j] = 0;
+
+    while (file[readCursor].i != -1 && readCursor < (gridSize * gridSize))
+    {
+        i = file[readCursor].i;
+        j = file[readCursor++].j;
+
+        if (j == targetJ)
+            break;
+
+        if (!QuoridorCore_hasWallAbove(self, i, j) && !explored[i - 1][j])
+        {
+            file[writeCursor].i = i - 1;
+            file[writeCursor++].j = j;
+
+            pred[i - 1][j].i = i;
+            pred[i - 1][j].j = j;
+
+            explored[i - 1][j] = true;
+            dist[i - 1][j] = dist[i][j] + 1;
+        }
+        if (!QuoridorCore_hasWallBelow(self, i, j) && !explored[i + 1][j])
+        {
+            file[writeCursor].i = i + 1;
+            file[writeCursor++].j = j;
+
+            pred[i + 1][j].i = i;
+            pred[i + 1][j].j = j;
+
+            explored[i + 1][j] = true;
+            dist[i + 1][j] = dist[i][j] + 1;
+        }
+        if (!QuoridorCore_hasWallLeft(self, i, j) && !explored[i][j - 1])
+        {
+            file[writeCursor].i = i;
+            file[writeCursor++].j = j - 1;
+
+            pred[i][j - 1].i = i;
+            pred[i][j - 1].j = j;
+
+            explored[i][j - 1] = true;
+            dist[i][j - 1] = dist[i][j] + 1;
+        }
+        if (!QuoridorCore_hasWallRight(self, i, j) && !explored[i][j + 1])
+        {
+            file[writeCursor].i = i;
+            file[writeCursor++].j = j + 1;
+
+            pred[i][j + 1].i = i;
+            pred[i][j + 1].j = j;
+
+            explored[i][j + 1] = true;
+            dist[i][j + 1] = dist[i][j] + 1;
+        }
+    }
+
+    *size = (int)dist[i][j] + 1;
+    QuoridorPos actual = {i, j};
+
+    for (int k = 0; k < *size; k++)
+    {
+        path[k].i = actual.i;
+        path[k].j = actual.j;
+
+        actual = pred[actual.i][actual.j];
+    }
+}
+
+/// @brief Nombre maximal d'entrées simultanées dans la file à priorité
+/// (la case de départ, puis au plus une entrée par voisin de chaque case développée).
+#define PATH_QUEUE_CAPACITY (4 * MAX_GRID_SIZE * MAX_GRID_SIZE + 1)
+
+/// @brief Nombre de priorités possibles (distance parcourue + heuristique).
+#define PATH_BUCKET_COUNT (MAX_PATH_LEN + MAX_GRID_SIZE)
+
+/// @brief Recherche de plus court chemin avec une file à priorité à compartiments (algorithme de Dial).
+/// La priorité d'une case est la distance parcourue, à laquelle on ajoute, pour l'algorithme A*,
+/// la distance en colonnes à la zone d'arrivée. Cette heuristique est cohérente :
+/// elle varie d'au plus 1 à chaque pas et est nulle sur la zone d'arrivée.
+/// Les priorités étant entières et croissantes, chaque compartiment est une simple pile.
+/// @param useHeuristic true pour l'algorithme A*, false pour l'algorithme de Dijkstra.
+static void QuoridorCore_getShortestPathBucket(
+    QuoridorCore *self, int playerID, QuoridorPos *path, int *size, bool useHeuristic)
+{
+    const int gridSize = self->gridSize;
+    const int targetJ = (playerID == 0) ? gridSize - 1 : 0;
+
+    uint8_t dist[MAX_GRID_SIZE * MAX_GRID_SIZE];
+    int8_t pred[MAX_GRID_SIZE * MAX_GRID_SIZE];
+    bool closed[MAX_GRID_SIZE * MAX_GRID_SIZE] = { 0 };
+    memset(dist, UINT8_MAX, sizeof(dist));
+
+    // Compartiments : listes chaînées d'entrées. Une case peut apparaître plusieurs fois,
+    // les entrées obsolètes sont ignorées au moment où elles sont retirées.
+    int bucketHeads[PATH_BUCKET_COUNT];
+    int entryCells[PATH_QUEUE_CAPACITY];
+    int entryNext[PATH_QUEUE_CAPACITY];
+    int entryCount = 0;
+    for (int b = 0; b < PATH_BUCKET_COUNT; b++)
+        bucketHeads[b] = -1;
+
+    const QuoridorPos start = self->positions[playerID];
+    const int startK = start.i * MAX_GRID_SIZE + start.j;
+    dist[startK] = 0;
+    pred[startK] = -1;
+
+    int bucket = useHeuristic ? abs(targetJ - start.j) : 0;
+    entryCells[entryCount] = startK;
+    entryNext[entryCount] = -1;
+    bucketHeads[bucket] = entryCount++;
+
+    int goalK = -1;
+    while (goalK < 0 && bucket < PATH_BUCKET_COUNT)
+    {
+        const int entry = bucketHeads[bucket];
+        if (entry < 0)
+        {
+            bucket++;
+            continue;
+        }
+        bucketHeads[bucket] = entryNext[entry];
+
+        const int k = entryCells[entry];
+        if (closed[k]) continue;
+        closed[k] = true;
+
+        const int i = k / MAX_GRID_SIZE;
+        const int j = k % MAX_GRID_SIZE;
+        if (j == targetJ)
+        {
+            goalK = k;
+            break;
+        }
+
+        int neighbors[4];
+        int count = 0;
+        if (!QuoridorCore_hasWallAbove(self, i, j)) neighbors[count++] = k - MAX_GRID_SIZE;
+        if (!QuoridorCore_hasWallBelow(self, i, j)) neighbors[count++] = k + MAX_GRID_SIZE;
+        if (!QuoridorCore_hasWallLeft(self, i, j)) neighbors[count++] = k - 1;
+        if (!QuoridorCore_hasWallRight(self, i, j)) neighbors[count++] = k + 1;
+
+        for (int n = 0; n < count; n++)
+        {
+            const int next = neighbors[n];
+            if (closed[next] || dist[next] <= dist[k] + 1) continue;
+
+            dist[next] = dist[k] + 1;
+            pred[next] = (int8_t)k;
+
+            const int nextBucket = dist[next] + (useHeuristic ? abs(targetJ - next % MAX_GRID_SIZE) : 0);
+            assert(entryCount < PATH_QUEUE_CAPACITY && nextBucket < PATH_BUCKET_COUNT);
+            entryCells[entryCount] = next;
+            entryNext[entryCount] = bucketHeads[nextBucket];
+            bucketHeads[nextBucket] = entryCount++;
+        }
+    }
+
+    assert(goalK >= 0 && "The goal must be reachable");
+
+    *size = dist[goalK] + 1;
+    int k = goalK;
+    for (int d = 0; d < *size; d++)
+    {
+        path[d].i = k / MAX_GRID_SIZE;
+        path[d].j = k % MAX_GRID_SIZE;
+        k = pred[k];
+    }
+}
+
+void QuoridorCore_getShortestPathWith(
+    QuoridorCore *self, QuoridorPathEngine engine, int playerID, QuoridorPos *path, int *size)
+{
+    switch (engine)
+    {
+    case QUORIDOR_PATH_BFS:
+        QuoridorCore_getShortestPathBFS(self, playerID, path, size);
+        break;
+    case QUORIDOR_PATH_BUCKET_QUEUE:
+        QuoridorCore_getShortestPathBucket(self, playerID, path, size, false);
+        break;
+    case QUORIDOR_PATH_ASTAR:
+        QuoridorCore_getShortestPathBucket(self, playerID, path, size, true);
+        break;
+    case QUORIDOR_PATH_DISTANCE_FIELD:
+    default:
+        QuoridorCore_getShortestPathDescent(self, playerID, path, size);
+        break;
+    }
+}
+
+void QuoridorCore_getShortestPath(QuoridorCore *self, int playerID, QuoridorPos *path, int *size)
+{
+    QuoridorCore_getShortestPathWith(self, s_pathEngines[self->gridSize], playerID, path, size);
+}
@@ -0,0 +1,66 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+
+/// @brief Algorithmes de recherche de plus court chemin.
+typedef enum QuoridorPathEngine
+{
+    /// @brief Descente dans le champ de distances maintenu par le plateau (aucun parcours).
+    QUORIDOR_PATH_DISTANCE_FIELD,
+
+    /// @brief Parcours en largeur depuis la position du joueur.
+    QUORIDOR_PATH_BFS,
+
+    /// @brief Algorithme de Dijkstra avec une file à priorité à compartiments.
+    QUORIDOR_PATH_BUCKET_QUEUE,
+
+    /// @brief Algorithme A*, avec la distance en colonnes à la zone d'arrivée comme heuristique.
+    QUORIDOR_PATH_ASTAR,
+
+    QUORIDOR_PATH_ENGINE_COUNT
+} QuoridorPathEngine;
+
+/// @brief Choisit l'algorithme utilisé par QuoridorCore_getShortestPath().
+/// Par défaut, le champ de distances est utilisé pour toutes les tailles de grille.
+/// Cette fonction ne doit pas être appelée pendant une recherche de l'IA.
+/// @param gridSize Taille de grille concernée, ou 0 pour toutes les tailles.
+/// @param engine Algorithme à utiliser.
+void QuoridorCore_setPathEngine(int gridSize, QuoridorPathEngine engine);
+
+/// @brief Renvoie l'algorithme utilisé par QuoridorCore_getShortestPath() pour une taille de grille.
+/// @param gridSize Taille de la grille.
+/// @return L'algorithme utilisé.
+QuoridorPathEngine QuoridorCore_getPathEngine(int gridSize);
+
+/// @brief Renvoie le nom d'un algorithme de recherche de plus court chemin.
+/// @param engine Algorithme.
+/// @return Le nom de l'algorithme.
+const char *QuoridorPathEngine_getName(QuoridorPathEngine engine);
+
+/// @brief Calcule le plus court chemin entre la position du joueur et sa zone d'arrivée.
+/// L'algorithme utilisé est celui choisi avec QuoridorCore_setPathEngine() pour la taille de la grille.
+/// @param self Instance du jeu Quoridor.
+/// @param playerID Identifiant du joueur (0 ou 1).
+/// @param path Tableau (préalloué, taille MAX_PATH_LEN) dans lequel sera écrit le plus court chemin.
+///     La position finale (dans la zone de victoire) est stockée à l'indice 0,
+///     et la position actuelle du joueur à l'indice (size - 1).
+/// @param size Adresse d'un entier dans lequel sera écrite la taille du chemin.
+///     La distance est alors égale à (size - 1).
+void QuoridorCore_getShortestPath(QuoridorCore *self, int playerID, QuoridorPos *path, int *size);
+
+/// @brief Calcule le plus court chemin entre la position du joueur et sa zone d'arrivée avec un algorithme donné.
+/// Tous les algorithmes renvoient un chemin de même longueur, mais pas nécessairement le même chemin.
+/// @param self Instance du jeu Quoridor.
+/// @param engine Algorithme à utiliser.
+/// @param playerID Identifiant du joueur (0 ou 1).
+/// @param path Tableau (préalloué, taille MAX_PATH_LEN) dans lequel sera écrit le plus court chemin.
+/// @param size Adresse d'un entier dans lequel sera écrite la taille du chemin.
+void QuoridorCore_getShortestPathWith(
+    QuoridorCore *self, QuoridorPathEngine engine, int playerID, QuoridorPos *path, int *size);
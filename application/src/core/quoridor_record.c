@@ -0,0 +1,326 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/quoridor_record.h"
+
+#define QUORIDOR_RECORD_VERSION 1
+#define QUORIDOR_RECORD_HEADER_SIZE 8
+#define QUORIDOR_RECORD_FOOTER_SIZE 6
+#define QUORIDOR_RECORD_CELL_COUNT (MAX_GRID_SIZE * MAX_GRID_SIZE)
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+static uint8_t QuoridorRecord_encodeTurn(QuoridorTurn turn)
+{
+    assert(turn.action != QUORIDOR_ACTION_UNDEFINED);
+    return (uint8_t)((turn.action - QUORIDOR_MOVE_TO) * QUORIDOR_RECORD_CELL_COUNT + turn.i * MAX_GRID_SIZE + turn.j);
+}
+
+/// @brief Décode un tour.
+/// @return false si l'octet ne correspond à aucun tour sur une grille de taille gridSize.
+static bool QuoridorRecord_decodeTurn(uint8_t code, int gridSize, QuoridorTurn *turn)
+{
+    if (code >= 3 * QUORIDOR_RECORD_CELL_COUNT)
+        return false;
+
+    const int k = code % QUORIDOR_RECORD_CELL_COUNT;
+    turn->action = (QuoridorAction)(QUORIDOR_MOVE_TO + code / QUORIDOR_RECORD_CELL_COUNT);
+    turn->i = k / MAX_GRID_SIZE;
+    turn->j = k % MAX_GRID_SIZE;
+    return turn->i < gridSize && turn->j < gridSize;
+}
+
+INLINE uint32_t QuoridorRecord_updateChecksum(uint32_t checksum, uint8_t byte)
+{
+    return (checksum ^ byte) * FNV_PRIME;
+}
+
+void QuoridorRecordHeader_init(QuoridorRecordHeader *self, const QuoridorCore *core, int tag)
+{
+    memset(self, 0, sizeof(QuoridorRecordHeader));
+
+    // Aucun mur posé ne bloque un chemin : les murs de départ peuvent être rejoués dans n'importe quel ordre.
+    for (int i = 0; i < core->gridSize - 1; i++)
+    {
+        for (int j = 0; j < core->gridSize - 1; j++)
+        {
+            const int k = i * MAX_GRID_SIZE + j;
+            if (QuoridorMask_test(core->hWalls, k) && self->startWallCount < QUORIDOR_RECORD_MAX_START_WALLS)
+                self->startWalls[self->startWallCount++] = (QuoridorTurn){ QUORIDOR_PLAY_HORIZONTAL_WALL, i, j };
+            if (QuoridorMask_test(core->vWalls, k) && self->startWallCount < QUORIDOR_RECORD_MAX_START_WALLS)
+                self->startWalls[self->startWallCount++] = (QuoridorTurn){ QUORIDOR_PLAY_VERTICAL_WALL, i, j };
+        }
+    }
+
+    // Les murs de départ sont ajoutés aux réserves des joueurs avant d'être posés (voir QuoridorCore_playStartWalls()) :
+    // les réserves restantes sont donc celles de la partie.
+    self->gridSize = core->gridSize;
+    self->wallCount = core->wallCounts[0];
+    self->firstPlayer = core->playerID ^ (self->startWallCount & 1);
+    self->tag = tag & 0xFF;
+}
+
+bool QuoridorRecordHeader_setStartPosition(const QuoridorRecordHeader *self, QuoridorCore *core)
+{
+    QuoridorCore_reset(core, self->gridSize, self->wallCount, self->firstPlayer);
+    return QuoridorCore_playStartWalls(core, self->startWalls, self->startWallCount);
+}
+
+void QuoridorRecord_clear(QuoridorRecord *self)
+{
+    if (!self) return;
+    free(self->turns);
+    memset(self, 0, sizeof(QuoridorRecord));
+}
+
+static void QuoridorRecord_addTurn(QuoridorRecord *self, QuoridorTurn turn)
+{
+    if (self->turnCount >= self->turnCapacity)
+    {
+        self->turnCapacity = (self->turnCapacity > 0) ? 2 * self->turnCapacity : 256;
+        self->turns = (QuoridorTurn *)realloc(self->turns, self->turnCapacity * sizeof(QuoridorTurn));
+        AssertNew(self->turns);
+    }
+    self->turns[self->turnCount++] = turn;
+}
+
+bool QuoridorRecordIndex_build(QuoridorRecordIndex *self, const QuoridorRecord *record)
+{
+    QuoridorRecordIndex_clear(self);
+
+    QuoridorCore core = { 0 };
+    if (!QuoridorRecordHeader_setStartPosition(&record->header, &core))
+        return false;
+
+    self->turns = record->turns;
+    self->turnCount = record->turnCount;
+    self->snapshots = (QuoridorCore *)calloc(
+        record->turnCount / QUORIDOR_RECORD_SNAPSHOT_INTERVAL + 1, sizeof(QuoridorCore));
+    AssertNew(self->snapshots);
+
+    for (int ply = 0; ply <= record->turnCount; ply++)
+    {
+        if (ply % QUORIDOR_RECORD_SNAPSHOT_INTERVAL == 0)
+            self->snapshots[self->snapshotCount++] = core;
+
+        if (ply == record->turnCount)
+            break;
+
+        const QuoridorTurn turn = record->turns[ply];
+        if (core.state != QUORIDOR_STATE_IN_PROGRESS || !QuoridorCore_canPlayTurn(&core, turn))
+        {
+            self->turnCount = ply;
+            break;
+        }
+        QuoridorCore_playTurn(&core, turn);
+    }
+    return true;
+}
+
+void QuoridorRecordIndex_clear(QuoridorRecordIndex *self)
+{
+    if (!self) return;
+    free(self->snapshots);
+    memset(self, 0, sizeof(QuoridorRecordIndex));
+}
+
+void QuoridorRecordIndex_getPosition(const QuoridorRecordIndex *self, int ply, QuoridorCore *core)
+{
+    assert(self->snapshots && "The index must be built");
+    assert(ply >= 0 && ply <= self->turnCount);
+
+    const int snapshotID = ply / QUORIDOR_RECORD_SNAPSHOT_INTERVAL;
+    *core = self->snapshots[snapshotID];
+    for (int k = snapshotID * QUORIDOR_RECORD_SNAPSHOT_INTERVAL; k < ply; k++)
+        QuoridorCore_playTurn(core, self->turns[k]);
+}
+
+QuoridorRecordWriter *QuoridorRecordWriter_create(const char *path, bool append)
+{
+    FILE *file = fopen(path, append ? "ab" : "wb");
+    if (file == NULL)
+        return NULL;
+
+    QuoridorRecordWriter *self = (QuoridorRecordWriter *)calloc(1, sizeof(QuoridorRecordWriter));
+    AssertNew(self);
+    self->file = file;
+
+    return self;
+}
+
+void QuoridorRecordWriter_destroy(QuoridorRecordWriter *self)
+{
+    if (!self) return;
+    QuoridorRecordWriter_flush(self);
+    fclose(self->file);
+    free(self);
+}
+
+void QuoridorRecordWriter_flush(QuoridorRecordWriter *self)
+{
+    if (self->bufferSize > 0)
+    {
+        fwrite(self->buffer, 1, self->bufferSize, self->file);
+        self->bufferSize = 0;
+    }
+    fflush(self->file);
+}
+
+/// @brief Ajoute un octet au tampon et à la somme de contrôle.
+static void QuoridorRecordWriter_put(QuoridorRecordWriter *self, uint8_t byte)
+{
+    if (self->bufferSize >= (int)sizeof(self->buffer))
+    {
+        fwrite(self->buffer, 1, self->bufferSize, self->file);
+        self->bufferSize = 0;
+    }
+    self->buffer[self->bufferSize++] = byte;
+    self->checksum = QuoridorRecord_updateChecksum(self->checksum, byte);
+}
+
+void QuoridorRecordWriter_beginGame(QuoridorRecordWriter *self, const QuoridorRecordHeader *header)
+{
+    if (self->inGame)
+        QuoridorRecordWriter_endGame(self, QUORIDOR_STATE_UNFINISHED);
+
+    assert(header->startWallCount <= QUORIDOR_RECORD_MAX_START_WALLS);
+
+    self->checksum = FNV_OFFSET_BASIS;
+    self->inGame = true;
+
+    QuoridorRecordWriter_put(self, 'Q');
+    QuoridorRecordWriter_put(self, 'G');
+    QuoridorRecordWriter_put(self, QUORIDOR_RECORD_VERSION);
+    QuoridorRecordWriter_put(self, (uint8_t)header->gridSize);
+    QuoridorRecordWriter_put(self, (uint8_t)header->wallCount);
+    QuoridorRecordWriter_put(self, (uint8_t)header->firstPlayer);
+    QuoridorRecordWriter_put(self, (uint8_t)header->tag);
+    QuoridorRecordWriter_put(self, (uint8_t)header->startWallCount);
+
+    for (int w = 0; w < header->startWallCount; w++)
+        QuoridorRecordWriter_put(self, QuoridorRecord_encodeTurn(header->startWalls[w]));
+}
+
+void QuoridorRecordWriter_addTurn(QuoridorRecordWriter *self, QuoridorTurn turn)
+{
+    assert(self->inGame && "QuoridorRecordWriter_beginGame() must be called first");
+    QuoridorRecordWriter_put(self, QuoridorRecord_encodeTurn(turn));
+}
+
+void QuoridorRecordWriter_endGame(QuoridorRecordWriter *self, int finalState)
+{
+    if (!self->inGame) return;
+
+    QuoridorRecordWriter_put(self, QUORIDOR_RECORD_END);
+    QuoridorRecordWriter_put(self, (uint8_t)finalState);
+
+    const uint32_t checksum = self->checksum;
+    for (int b = 0; b < 4; b++)
+        QuoridorRecordWriter_put(self, (uint8_t)(checksum >> (8 * b)));
+
+    self->inGame = false;
+}
+
+QuoridorRecordReader *QuoridorRecordReader_create(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+        return NULL;
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    QuoridorRecordReader *self = (QuoridorRecordReader *)calloc(1, sizeof(QuoridorRecordReader));
+    AssertNew(self);
+
+    if (size > 0)
+    {
+        self->data = (uint8_t *)malloc(size);
+        AssertNew(self->data);
+        self->size = fread(self->data, 1, size, file);
+    }
+    fclose(file);
+
+    return self;
+}
+
+void QuoridorRecordReader_destroy(QuoridorRecordReader *self)
+{
+    if (!self) return;
+    free(self->data);
+    free(self);
+}
+
+bool QuoridorRecordReader_next(QuoridorRecordReader *self, QuoridorRecord *record)
+{
+    const uint8_t *data = self->data;
+    size_t p = self->offset;
+
+    if (self->corrupted || p >= self->size)
+        return false;
+
+    self->corrupted = true;
+    if (self->size - p < QUORIDOR_RECORD_HEADER_SIZE
+        || data[p] != 'Q' || data[p + 1] != 'G' || data[p + 2] != QUORIDOR_RECORD_VERSION)
+        return false;
+
+    QuoridorRecordHeader *header = &record->header;
+    memset(header, 0, sizeof(QuoridorRecordHeader));
+    header->gridSize = data[p + 3];
+    header->wallCount = data[p + 4];
+    header->firstPlayer = data[p + 5];
+    header->tag = data[p + 6];
+    header->startWallCount = data[p + 7];
+    if (header->gridSize < 2 || header->gridSize > MAX_GRID_SIZE || header->firstPlayer > 1
+        || header->startWallCount > QUORIDOR_RECORD_MAX_START_WALLS
+        || self->size - p < QUORIDOR_RECORD_HEADER_SIZE + (size_t)header->startWallCount)
+        return false;
+
+    uint32_t checksum = FNV_OFFSET_BASIS;
+    for (int b = 0; b < QUORIDOR_RECORD_HEADER_SIZE; b++)
+        checksum = QuoridorRecord_updateChecksum(checksum, data[p++]);
+
+    for (int w = 0; w < header->startWallCount; w++)
+    {
+        QuoridorTurn *wall = &header->startWalls[w];
+        if (!QuoridorRecord_decodeTurn(data[p], header->gridSize, wall) || wall->action == QUORIDOR_MOVE_TO)
+            return false;
+        checksum = QuoridorRecord_updateChecksum(checksum, data[p++]);
+    }
+
+    record->turnCount = 0;
+    record->finalState = QUORIDOR_STATE_IN_PROGRESS;
+    for (; p < self->size && data[p] != QUORIDOR_RECORD_END; p++)
+    {
+        QuoridorTurn turn;
+        if (!QuoridorRecord_decodeTurn(data[p], header->gridSize, &turn))
+            return false;
+        QuoridorRecord_addTurn(record, turn);
+        checksum = QuoridorRecord_updateChecksum(checksum, data[p]);
+    }
+
+    if (p < self->size)
+    {
+        if (self->size - p < QUORIDOR_RECORD_FOOTER_SIZE)
+            return false;
+
+        checksum = QuoridorRecord_updateChecksum(checksum, data[p]);
+        checksum = QuoridorRecord_updateChecksum(checksum, data[p + 1]);
+        const uint32_t stored = (uint32_t)data[p + 2] | ((uint32_t)data[p + 3] << 8)
+            | ((uint32_t)data[p + 4] << 16) | ((uint32_t)data[p + 5] << 24);
+        if (stored != checksum)
+            return false;
+
+        record->finalState = data[p + 1];
+        p += QUORIDOR_RECORD_FOOTER_SIZE;
+    }
+
+    self->offset = p;
+    self->corrupted = false;
+    return true;
+}
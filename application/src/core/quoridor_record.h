@@ -0,0 +1,201 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+
+// Format binaire des parties enregistrées.
+// Un fichier est une suite de parties, chacune codée ainsi :
+//   "QG", version (1), taille de la grille, murs par joueur, premier joueur,
+//   étiquette, nombre de murs de départ                                      (8 octets)
+//   murs de départ                                                           (1 octet chacun)
+//   tours                                                                    (1 octet chacun)
+//   QUORIDOR_RECORD_END, état final (QuoridorState)                          (2 octets)
+//   somme de contrôle FNV-1a de tous les octets précédents de la partie      (4 octets, petit-boutiste)
+// Un tour est codé par (action - QUORIDOR_MOVE_TO) * 81 + i * 9 + j (de 0 à 242).
+// Une partie sans marqueur de fin (partie en cours ou programme interrompu) ne peut être
+// que la dernière du fichier : elle est lue sans vérification de la somme de contrôle.
+
+/// @brief Nombre maximal de murs de départ d'une partie enregistrée.
+#define QUORIDOR_RECORD_MAX_START_WALLS 16
+
+/// @brief Octet marquant la fin des tours d'une partie.
+#define QUORIDOR_RECORD_END 0xFF
+
+/// @brief Position de départ d'une partie enregistrée.
+typedef struct QuoridorRecordHeader
+{
+    /// @brief Taille de la grille.
+    int gridSize;
+
+    /// @brief Nombre de murs de chaque joueur, sans compter les murs de départ.
+    int wallCount;
+
+    /// @brief Joueur qui pose le premier mur de départ (ou joue le premier tour).
+    int firstPlayer;
+
+    /// @brief Valeur libre entre 0 et 255 (mode de jeu, configuration de l'IA, etc.).
+    int tag;
+
+    /// @brief Murs de départ, rejoués avec QuoridorCore_playStartWalls().
+    QuoridorTurn startWalls[QUORIDOR_RECORD_MAX_START_WALLS];
+    int startWallCount;
+} QuoridorRecordHeader;
+
+/// @brief Initialise l'en-tête d'une partie à partir de sa position de départ
+/// (juste après QuoridorCore_reset() et éventuellement QuoridorCore_randomStart()).
+/// Les murs déjà posés deviennent les murs de départ.
+/// @param self En-tête à initialiser.
+/// @param core Position de départ, avant le premier tour.
+/// @param tag Valeur libre entre 0 et 255.
+void QuoridorRecordHeader_init(QuoridorRecordHeader *self, const QuoridorCore *core, int tag);
+
+/// @brief Place le plateau dans la position de départ d'une partie.
+/// @param self En-tête de la partie.
+/// @param core Instance du jeu Quoridor.
+/// @return false si les murs de départ ne peuvent pas être posés.
+bool QuoridorRecordHeader_setStartPosition(const QuoridorRecordHeader *self, QuoridorCore *core);
+
+/// @brief Partie lue dans un fichier.
+typedef struct QuoridorRecord
+{
+    /// @brief Position de départ.
+    QuoridorRecordHeader header;
+
+    /// @brief Tours joués depuis la position de départ.
+    QuoridorTurn *turns;
+    int turnCount;
+    int turnCapacity;
+
+    /// @brief État à la fin de la partie (QuoridorState).
+    /// Vaut QUORIDOR_STATE_IN_PROGRESS pour une partie sans marqueur de fin.
+    int finalState;
+} QuoridorRecord;
+
+/// @brief Libère les tours d'une partie lue.
+/// @param self Partie.
+void QuoridorRecord_clear(QuoridorRecord *self);
+
+/// @brief Nombre de tours séparant deux positions mémorisées par QuoridorRecordIndex.
+#define QUORIDOR_RECORD_SNAPSHOT_INTERVAL 8
+
+/// @brief Accès direct aux positions d'une partie lue.
+/// Une copie du plateau est conservée tous les QUORIDOR_RECORD_SNAPSHOT_INTERVAL tours :
+/// n'importe quelle position est reconstruite en rejouant moins de QUORIDOR_RECORD_SNAPSHOT_INTERVAL tours,
+/// si bien qu'avancer, reculer ou sauter à un tour quelconque se fait en temps constant.
+typedef struct QuoridorRecordIndex
+{
+    /// @brief Tours de la partie indexée (non copiés : la partie doit rester valide).
+    const QuoridorTurn *turns;
+
+    /// @brief Nombre de tours accessibles.
+    /// La partie est tronquée au premier tour illégal ou joué après la fin de la partie.
+    int turnCount;
+
+    /// @brief Position après k * QUORIDOR_RECORD_SNAPSHOT_INTERVAL tours, pour chaque k.
+    QuoridorCore *snapshots;
+    int snapshotCount;
+} QuoridorRecordIndex;
+
+/// @brief Indexe une partie en la rejouant une fois.
+/// L'index précédent éventuel est libéré.
+/// @param self Index (initialisé à zéro avant le premier appel).
+/// @param record Partie à indexer.
+/// @return false si les murs de départ de la partie ne peuvent pas être posés.
+bool QuoridorRecordIndex_build(QuoridorRecordIndex *self, const QuoridorRecord *record);
+
+/// @brief Libère un index.
+/// @param self Index.
+void QuoridorRecordIndex_clear(QuoridorRecordIndex *self);
+
+/// @brief Place le plateau dans la position atteinte après un nombre de tours donné.
+/// @param self Index.
+/// @param ply Nombre de tours joués depuis la position de départ (entre 0 et turnCount).
+/// @param core Instance du jeu Quoridor.
+void QuoridorRecordIndex_getPosition(const QuoridorRecordIndex *self, int ply, QuoridorCore *core);
+
+/// @brief Écrit des parties dans un fichier.
+/// Les octets sont accumulés dans un tampon et écrits par blocs : le fichier reste ouvert
+/// pendant toute la durée d'utilisation et n'est complété qu'à la fin (ajout seulement).
+typedef struct QuoridorRecordWriter
+{
+    /// @brief Fichier de destination.
+    FILE *file;
+
+    /// @brief Octets en attente d'écriture.
+    uint8_t buffer[4096];
+    int bufferSize;
+
+    /// @brief Somme de contrôle de la partie en cours.
+    uint32_t checksum;
+
+    /// @brief Indique si une partie est en cours d'écriture.
+    bool inGame;
+} QuoridorRecordWriter;
+
+/// @brief Ouvre un fichier de parties en écriture.
+/// @param path Chemin du fichier.
+/// @param append true pour ajouter les parties à la fin du fichier, false pour le vider.
+/// @return Le writer créé, ou NULL si le fichier ne peut pas être ouvert.
+QuoridorRecordWriter *QuoridorRecordWriter_create(const char *path, bool append);
+
+/// @brief Termine l'écriture et ferme le fichier.
+/// Une partie en cours reste sans marqueur de fin.
+/// @param self Writer (peut être NULL).
+void QuoridorRecordWriter_destroy(QuoridorRecordWriter *self);
+
+/// @brief Commence une nouvelle partie.
+/// Une partie précédente non terminée est terminée avec l'état QUORIDOR_STATE_UNFINISHED.
+/// @param self Writer.
+/// @param header Position de départ.
+void QuoridorRecordWriter_beginGame(QuoridorRecordWriter *self, const QuoridorRecordHeader *header);
+
+/// @brief Ajoute un tour à la partie en cours.
+/// @param self Writer.
+/// @param turn Tour joué.
+void QuoridorRecordWriter_addTurn(QuoridorRecordWriter *self, QuoridorTurn turn);
+
+/// @brief Termine la partie en cours.
+/// @param self Writer.
+/// @param finalState État à la fin de la partie (QuoridorState).
+void QuoridorRecordWriter_endGame(QuoridorRecordWriter *self, int finalState);
+
+/// @brief Écrit les octets en attente dans le fichier.
+/// @param self Writer.
+void QuoridorRecordWriter_flush(QuoridorRecordWriter *self);
+
+/// @brief Lit les parties d'un fichier.
+/// Le fichier est chargé en mémoire en une seule lecture.
+typedef struct QuoridorRecordReader
+{
+    /// @brief Contenu du fichier.
+    uint8_t *data;
+    size_t size;
+
+    /// @brief Position de la prochaine partie dans data.
+    size_t offset;
+
+    /// @brief Indique si une partie invalide (somme de contrôle, tour inconnu) a été rencontrée.
+    bool corrupted;
+} QuoridorRecordReader;
+
+/// @brief Ouvre un fichier de parties en lecture.
+/// @param path Chemin du fichier.
+/// @return Le reader créé, ou NULL si le fichier ne peut pas être lu.
+QuoridorRecordReader *QuoridorRecordReader_create(const char *path);
+
+/// @brief Détruit un reader.
+/// @param self Reader (peut être NULL).
+void QuoridorRecordReader_destroy(QuoridorRecordReader *self);
+
+/// @brief Lit la partie suivante.
+/// La lecture s'arrête à la première partie invalide (voir QuoridorRecordReader.corrupted).
+/// @param self Reader.
+/// @param record Partie lue (ses tours sont réutilisés d'un appel à l'autre, libérer avec QuoridorRecord_clear()).
+/// @return false s'il n'y a plus de partie valide à lire.
+bool QuoridorRecordReader_next(QuoridorRecordReader *self, QuoridorRecord *record);
@@ -0,0 +1,99 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/quoridor_stats.h"
+#include <stdarg.h>
+
+void AIStats_clear(AIStats *self)
+{
+    memset(self, 0, sizeof(AIStats));
+}
+
+void AIStats_merge(AIStats *self, const AIStats *other)
+{
+    self->nodeCount += other->nodeCount;
+    for (int d = 0; d < AI_STATS_DEPTH_COUNT; d++)
+        self->nodesAtDepth[d] += other->nodesAtDepth[d];
+
+    self->cutoffCount += other->cutoffCount;
+    self->firstMoveCutoffCount += other->firstMoveCutoffCount;
+    self->ttProbeCount += other->ttProbeCount;
+    self->ttHitCount += other->ttHitCount;
+    self->ttCutoffCount += other->ttCutoffCount;
+}
+
+double AIStats_getNPS(const AIStats *self)
+{
+    return (self->totalMS > 0.0) ? (double)self->nodeCount * 1000.0 / self->totalMS : 0.0;
+}
+
+double AIStats_getFirstMoveCutoffRate(const AIStats *self)
+{
+    return (self->cutoffCount > 0) ? (double)self->firstMoveCutoffCount / (double)self->cutoffCount : 0.0;
+}
+
+double AIStats_getTTHitRate(const AIStats *self)
+{
+    return (self->ttProbeCount > 0) ? (double)self->ttHitCount / (double)self->ttProbeCount : 0.0;
+}
+
+double AIStats_getBranchingFactor(const AIStats *self)
+{
+    const int n = self->iterationCount;
+    if (n >= 2 && self->iterationNodes[n - 2] > 0)
+        return (double)self->iterationNodes[n - 1] / (double)self->iterationNodes[n - 2];
+    if (n == 1 && self->depth > 0 && self->nodeCount > 0)
+        return pow((double)self->nodeCount, 1.0 / self->depth);
+    return 0.0;
+}
+
+/// @brief Ajoute du texte à un tampon, comme snprintf(), en tenant compte de la place déjà utilisée.
+static void AIStats_append(char *buffer, size_t size, int *length, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    const size_t offset = (size_t)*length;
+    const int count = vsnprintf(
+        (offset < size) ? buffer + offset : NULL, (offset < size) ? size - offset : 0, format, args);
+    va_end(args);
+
+    if (count > 0)
+        *length += count;
+}
+
+int AIStats_toJSON(const AIStats *self, char *buffer, size_t size)
+{
+    int length = 0;
+    if (size > 0) buffer[0] = '\0';
+
+    AIStats_append(buffer, size, &length,
+        "{\"depth\":%d,\"nodes\":%llu,\"timeMS\":%.3f,\"nps\":%.0f,\"threads\":%d,"
+        "\"ebf\":%.3f,\"firstMoveCutoffRate\":%.4f,\"cutoffs\":%llu,"
+        "\"ttProbes\":%llu,\"ttHits\":%llu,\"ttHitRate\":%.4f,\"ttCutoffs\":%llu,",
+        self->depth, (unsigned long long)self->nodeCount, self->totalMS, AIStats_getNPS(self), self->threadCount,
+        AIStats_getBranchingFactor(self), AIStats_getFirstMoveCutoffRate(self), (unsigned long long)self->cutoffCount,
+        (unsigned long long)self->ttProbeCount, (unsigned long long)self->ttHitCount,
+        AIStats_getTTHitRate(self), (unsigned long long)self->ttCutoffCount);
+
+    // Noeuds par profondeur, jusqu'à la dernière profondeur atteinte.
+    int depthCount = AI_STATS_DEPTH_COUNT;
+    while (depthCount > 0 && self->nodesAtDepth[depthCount - 1] == 0)
+        depthCount--;
+
+    AIStats_append(buffer, size, &length, "\"nodesAtDepth\":[");
+    for (int d = 0; d < depthCount; d++)
+        AIStats_append(buffer, size, &length, "%s%llu", d ? "," : "", (unsigned long long)self->nodesAtDepth[d]);
+
+    AIStats_append(buffer, size, &length, "],\"iterations\":[");
+    for (int i = 0; i < self->iterationCount; i++)
+    {
+        AIStats_append(buffer, size, &length, "%s{\"timeMS\":%.3f,\"nodes\":%llu}",
+            i ? "," : "", self->iterationMS[i], (unsigned long long)self->iterationNodes[i]);
+    }
+    AIStats_append(buffer, size, &length, "]}");
+
+    return length;
+}
@@ -0,0 +1,153 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include <stdint.h>
+
+/// @brief Active la collecte des statistiques de la recherche min-max (option CMake AI_STATS).
+/// Avec la valeur 0 (par défaut), les fonctions de comptage sont vides et la recherche n'est pas ralentie ;
+/// seuls la durée et le nombre de threads sont alors renseignés.
+#ifndef AI_STATS
+#define AI_STATS 0
+#endif
+
+/// @brief Nombre de profondeurs (distance à la racine) pour lesquelles les noeuds sont comptés.
+/// Les noeuds plus profonds sont comptés avec la dernière.
+#define AI_STATS_DEPTH_COUNT 33
+
+/// @brief Statistiques d'une recherche min-max.
+/// Chaque thread remplit sa propre instance ; elles sont additionnées avec AIStats_merge()
+/// une fois les threads terminés, si bien qu'aucun compteur n'est partagé pendant la recherche.
+typedef struct AIStats
+{
+    /// @brief Nombre de noeuds visités.
+    uint64_t nodeCount;
+
+    /// @brief Nombre de noeuds visités à chaque distance de la racine (toutes itérations confondues).
+    uint64_t nodesAtDepth[AI_STATS_DEPTH_COUNT];
+
+    /// @brief Nombre de noeuds dont l'exploration s'est arrêtée sur une coupure alpha-bêta.
+    uint64_t cutoffCount;
+
+    /// @brief Nombre de coupures produites par le premier fils exploré (qualité de l'ordre des coups).
+    uint64_t firstMoveCutoffCount;
+
+    /// @brief Nombre de lectures dans la table de transposition.
+    uint64_t ttProbeCount;
+
+    /// @brief Nombre de lectures ayant trouvé la position.
+    uint64_t ttHitCount;
+
+    /// @brief Nombre de noeuds dont le score a été lu directement dans la table.
+    uint64_t ttCutoffCount;
+
+    /// @brief Nombre d'itérations terminées (approfondissement itératif, 1 pour une profondeur fixe).
+    int iterationCount;
+
+    /// @brief Durée de chaque itération terminée, en millisecondes.
+    double iterationMS[AI_STATS_DEPTH_COUNT];
+
+    /// @brief Nombre de noeuds comptés par le thread principal pendant chaque itération terminée.
+    /// Avec la séparation à la racine, il inclut ceux des threads qui explorent les fils de la racine,
+    /// additionnés à la fin de chaque itération ; les threads Lazy SMP et YBWC ne sont additionnés
+    /// qu'à la fin de la recherche et n'y figurent pas.
+    uint64_t iterationNodes[AI_STATS_DEPTH_COUNT];
+
+    /// @brief Profondeur de la dernière itération terminée.
+    int depth;
+
+    /// @brief Durée totale de la recherche, en millisecondes.
+    double totalMS;
+
+    /// @brief Nombre de threads de la recherche.
+    int threadCount;
+} AIStats;
+
+/// @brief Remet à zéro des statistiques.
+/// @param self Statistiques.
+void AIStats_clear(AIStats *self);
+
+/// @brief Ajoute les compteurs d'un thread aux statistiques d'une recherche.
+/// Les itérations, la durée et le nombre de threads ne sont pas modifiés.
+/// @param self Statistiques de la recherche.
+/// @param other Statistiques d'un thread.
+void AIStats_merge(AIStats *self, const AIStats *other);
+
+/// @brief Renvoie le nombre de noeuds visités par seconde.
+double AIStats_getNPS(const AIStats *self);
+
+/// @brief Renvoie la proportion des coupures produites par le premier fils (entre 0 et 1).
+double AIStats_getFirstMoveCutoffRate(const AIStats *self);
+
+/// @brief Renvoie la proportion des lectures de la table de transposition ayant trouvé la position (entre 0 et 1).
+double AIStats_getTTHitRate(const AIStats *self);
+
+/// @brief Renvoie le facteur de branchement effectif :
+/// rapport entre les nombres de noeuds des deux dernières itérations terminées
+/// (racine n-ième du nombre total de noeuds pour une seule itération de profondeur n).
+double AIStats_getBranchingFactor(const AIStats *self);
+
+/// @brief Écrit les statistiques au format JSON (sur une ligne).
+/// @param self Statistiques.
+/// @param buffer Tampon de destination (la chaîne est toujours terminée par un zéro).
+/// @param size Taille du tampon.
+/// @return Le nombre de caractères nécessaires, comme snprintf().
+int AIStats_toJSON(const AIStats *self, char *buffer, size_t size);
+
+/// @brief Compte un noeud visité.
+INLINE void AIStats_countNode(AIStats *self, int depth)
+{
+#if AI_STATS
+    self->nodeCount++;
+    self->nodesAtDepth[(depth < AI_STATS_DEPTH_COUNT) ? depth : AI_STATS_DEPTH_COUNT - 1]++;
+#endif
+}
+
+/// @brief Compte une lecture dans la table de transposition.
+INLINE void AIStats_countProbe(AIStats *self, bool hit)
+{
+#if AI_STATS
+    self->ttProbeCount++;
+    self->ttHitCount += hit;
+#endif
+}
+
+/// @brief Compte un score lu directement dans la table de transposition.
+INLINE void AIStats_countTTCutoff(AIStats *self)
+{
+#if AI_STATS
+    self->ttCutoffCount++;
+#endif
+}
+
+/// @brief Compte une coupure alpha-bêta produite par le fils d'indice childIndex.
+INLINE void AIStats_countCutoff(AIStats *self, int childIndex)
+{
+#if AI_STATS
+    self->cutoffCount++;
+    self->firstMoveCutoffCount += (childIndex == 0);
+#endif
+}
+
+/// @brief Enregistre une itération terminée.
+/// @param self Statistiques.
+/// @param depth Profondeur de l'itération.
+/// @param ms Durée de l'itération, en millisecondes.
+/// @param nodeCount Nombre de noeuds comptés par le thread principal pendant l'itération (voir AIStats.iterationNodes).
+INLINE void AIStats_addIteration(AIStats *self, int depth, double ms, uint64_t nodeCount)
+{
+#if AI_STATS
+    if (self->iterationCount < AI_STATS_DEPTH_COUNT)
+    {
+        self->iterationMS[self->iterationCount] = ms;
+        self->iterationNodes[self->iterationCount] = nodeCount;
+        self->iterationCount++;
+    }
+    self->depth = depth;
+#endif
+}
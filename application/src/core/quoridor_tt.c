@@ -0,0 +1,163 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#include "core/quoridor_tt.h"
+#include "core/utils.h"
+#include <limits.h>
+
+// Organisation des 64 bits de QuoridorTTEntry.data :
+// [0, 32) score (float) | [32, 42) tour | [42, 50) profondeur | [50, 52) borne | [52, 64) génération
+#define TT_TURN_SHIFT 32
+#define TT_DEPTH_SHIFT 42
+#define TT_BOUND_SHIFT 50
+#define TT_GENERATION_SHIFT 52
+#define TT_GENERATION_MASK 0xFFF
+
+static uint64_t QuoridorTT_pack(const QuoridorTTData *data, int generation)
+{
+    uint32_t scoreBits;
+    memcpy(&scoreBits, &data->score, sizeof(scoreBits));
+
+    const uint64_t turnBits = ((uint64_t)(data->turn.action & 3) << 8)
+        | ((uint64_t)(data->turn.i & 15) << 4)
+        | (uint64_t)(data->turn.j & 15);
+
+    return (uint64_t)scoreBits
+        | (turnBits << TT_TURN_SHIFT)
+        | ((uint64_t)Int_clamp(data->depth, 0, 255) << TT_DEPTH_SHIFT)
+        | ((uint64_t)(data->bound & 3) << TT_BOUND_SHIFT)
+        | ((uint64_t)(generation & TT_GENERATION_MASK) << TT_GENERATION_SHIFT);
+}
+
+static void QuoridorTT_unpack(uint64_t bits, QuoridorTTData *data)
+{
+    uint32_t scoreBits = (uint32_t)bits;
+    memcpy(&data->score, &scoreBits, sizeof(scoreBits));
+
+    const int turnBits = (int)((bits >> TT_TURN_SHIFT) & 0x3FF);
+    data->turn.action = (QuoridorAction)(turnBits >> 8);
+    data->turn.i = (turnBits >> 4) & 15;
+    data->turn.j = turnBits & 15;
+
+    data->depth = (int)((bits >> TT_DEPTH_SHIFT) & 0xFF);
+    data->bound = (QuoridorBound)((bits >> TT_BOUND_SHIFT) & 3);
+}
+
+static int QuoridorTT_getGeneration(uint64_t bits)
+{
+    return (int)((bits >> TT_GENERATION_SHIFT) & TT_GENERATION_MASK);
+}
+
+QuoridorTT *QuoridorTT_create(int log2BucketCount)
+{
+    assert(0 < log2BucketCount && log2BucketCount < 32);
+
+    QuoridorTT *self = (QuoridorTT *)calloc(1, sizeof(QuoridorTT));
+    AssertNew(self);
+
+    const size_t bucketCount = (size_t)1 << log2BucketCount;
+    self->buckets = (QuoridorTTBucket *)calloc(bucketCount, sizeof(QuoridorTTBucket));
+    AssertNew(self->buckets);
+
+    self->indexMask = bucketCount - 1;
+
+    return self;
+}
+
+void QuoridorTT_destroy(QuoridorTT *self)
+{
+    if (!self) return;
+    free(self->buckets);
+    free(self);
+}
+
+void QuoridorTT_clear(QuoridorTT *self)
+{
+    assert(self && "The QuoridorTT must be created");
+    memset(self->buckets, 0, (size_t)(self->indexMask + 1) * sizeof(QuoridorTTBucket));
+    self->generation = 0;
+}
+
+void QuoridorTT_newSearch(QuoridorTT *self)
+{
+    assert(self && "The QuoridorTT must be created");
+    self->generation = (self->generation + 1) & TT_GENERATION_MASK;
+}
+
+bool QuoridorTT_probe(QuoridorTT *self, uint64_t key, QuoridorTTData *data)
+{
+    assert(self && "The QuoridorTT must be created");
+    const volatile QuoridorTTEntry *bucket = self->buckets[key & self->indexMask].entries;
+
+    for (int k = 0; k < QUORIDOR_TT_BUCKET_SIZE; k++)
+    {
+        // Chaque champ n'est lu qu'une fois : une entrée modifiée en même temps par un autre thread
+        // donne une clé incohérente et elle est ignorée.
+        const uint64_t entryKey = bucket[k].key;
+        const uint64_t entryData = bucket[k].data;
+        if ((entryKey ^ entryData) == key && entryData != 0)
+        {
+            QuoridorTT_unpack(entryData, data);
+            return true;
+        }
+    }
+    return false;
+}
+
+void QuoridorTT_store(QuoridorTT *self, uint64_t key, const QuoridorTTData *data)
+{
+    assert(self && "The QuoridorTT must be created");
+    volatile QuoridorTTEntry *bucket = self->buckets[key & self->indexMask].entries;
+
+    // On réutilise l'entrée de la même position si elle existe.
+    // Sinon, on remplace l'entrée la moins utile :
+    // une entrée vide, puis une entrée d'une ancienne recherche, puis la moins profonde.
+    volatile QuoridorTTEntry *replace = NULL;
+    uint64_t replaceData = 0;
+    bool sameKey = false;
+    int replaceValue = INT_MAX;
+
+    for (int k = 0; k < QUORIDOR_TT_BUCKET_SIZE; k++)
+    {
+        volatile QuoridorTTEntry *entry = &bucket[k];
+        const uint64_t entryData = entry->data;
+        sameKey = (entry->key ^ entryData) == key;
+        if (sameKey || entryData == 0)
+        {
+            replace = entry;
+            replaceData = entryData;
+            break;
+        }
+
+        QuoridorTTData other;
+        QuoridorTT_unpack(entryData, &other);
+        int value = other.depth;
+        if (QuoridorTT_getGeneration(entryData) == self->generation)
+            value += 256;
+
+        if (value < replaceValue)
+        {
+            replace = entry;
+            replaceData = entryData;
+            replaceValue = value;
+        }
+    }
+
+    // On conserve une analyse plus profonde de la même position issue de la recherche en cours,
+    // sauf si le nouveau score est exact.
+    if (sameKey && replaceData != 0 && data->bound != QUORIDOR_BOUND_EXACT
+        && QuoridorTT_getGeneration(replaceData) == self->generation)
+    {
+        QuoridorTTData other;
+        QuoridorTT_unpack(replaceData, &other);
+        if (other.depth > data->depth)
+            return;
+    }
+
+    const uint64_t packed = QuoridorTT_pack(data, self->generation);
+    replace->key = key ^ packed;
+    replace->data = packed;
+}
@@ -0,0 +1,111 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+#pragma once
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+
+/// @brief Nombre d'entrées par bucket de la table de transposition.
+/// Un bucket occupe 64 octets, soit une ligne de cache.
+#define QUORIDOR_TT_BUCKET_SIZE 4
+
+typedef enum QuoridorBound
+{
+    /// @brief Entrée vide.
+    QUORIDOR_BOUND_NONE,
+
+    /// @brief Le score est un majorant de la valeur de la position (échec bas).
+    QUORIDOR_BOUND_UPPER,
+
+    /// @brief Le score est un minorant de la valeur de la position (échec haut).
+    QUORIDOR_BOUND_LOWER,
+
+    /// @brief Le score est la valeur exacte de la position.
+    QUORIDOR_BOUND_EXACT,
+} QuoridorBound;
+
+/// @brief Informations stockées pour une position dans la table de transposition.
+typedef struct QuoridorTTData
+{
+    /// @brief Score de la position, du point de vue du joueur qui doit jouer.
+    float score;
+
+    /// @brief Meilleur tour trouvé depuis cette position.
+    QuoridorTurn turn;
+
+    /// @brief Profondeur restante de la recherche ayant produit le score.
+    int depth;
+
+    /// @brief Type de borne associé au score.
+    QuoridorBound bound;
+} QuoridorTTData;
+
+/// @brief Entrée (compactée sur 16 octets) de la table de transposition.
+typedef struct QuoridorTTEntry
+{
+    /// @brief Clé de Zobrist de la position, combinée (ou exclusif) avec le champ data.
+    /// Une entrée dont les deux champs ont été écrits par des threads différents
+    /// ne correspond plus à sa clé et elle est ignorée.
+    uint64_t key;
+
+    /// @brief Score, tour, profondeur, borne et génération compactés.
+    uint64_t data;
+} QuoridorTTEntry;
+
+/// @brief Ensemble d'entrées partageant le même indice dans la table.
+typedef struct QuoridorTTBucket
+{
+    QuoridorTTEntry entries[QUORIDOR_TT_BUCKET_SIZE];
+} QuoridorTTBucket;
+
+/// @brief Table de transposition de taille fixe utilisée par la recherche alpha-bêta.
+/// Elle peut être partagée sans verrou par plusieurs threads d'une même recherche :
+/// les entrées incohérentes sont détectées à la lecture (cf. QuoridorTTEntry).
+/// QuoridorTT_clear() et QuoridorTT_newSearch() ne doivent être appelées qu'en l'absence de recherche.
+typedef struct QuoridorTT
+{
+    /// @brief Tableau des buckets (taille : une puissance de deux).
+    QuoridorTTBucket *buckets;
+
+    /// @brief Masque appliqué à la clé pour obtenir l'indice du bucket.
+    uint64_t indexMask;
+
+    /// @brief Génération courante, incrémentée à chaque nouvelle recherche.
+    /// Les entrées des recherches précédentes sont remplacées en priorité.
+    int generation;
+} QuoridorTT;
+
+/// @brief Crée une table de transposition.
+/// @param log2BucketCount Logarithme en base 2 du nombre de buckets.
+/// @return Un pointeur vers la table créée.
+QuoridorTT *QuoridorTT_create(int log2BucketCount);
+
+/// @brief Détruit une table de transposition.
+/// @param self Table à détruire.
+void QuoridorTT_destroy(QuoridorTT *self);
+
+/// @brief Vide une table de transposition.
+/// @param self Table de transposition.
+void QuoridorTT_clear(QuoridorTT *self);
+
+/// @brief Indique le début d'une nouvelle recherche.
+/// Les entrées existantes restent utilisables mais deviennent prioritaires pour le remplacement.
+/// @param self Table de transposition.
+void QuoridorTT_newSearch(QuoridorTT *self);
+
+/// @brief Recherche une position dans la table.
+/// @param self Table de transposition.
+/// @param key Clé de Zobrist de la position.
+/// @param data Adresse dans laquelle sont écrites les informations trouvées.
+/// @return true si la position est présente dans la table, false sinon.
+bool QuoridorTT_probe(QuoridorTT *self, uint64_t key, QuoridorTTData *data);
+
+/// @brief Enregistre une position dans la table.
+/// @param self Table de transposition.
+/// @param key Clé de Zobrist de la position.
+/// @param data Informations à enregistrer.
+void QuoridorTT_store(QuoridorTT *self, uint64_t key, const QuoridorTTData *data);
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include "settings.h"
+#include "core/core_settings.h"
 
 /// @brief Borne un entier entre une valeur minimale et une valeur maximale.
 /// @param value Valeur à borner.
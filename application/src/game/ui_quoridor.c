@@ -8,25 +8,32 @@
 #include "game/game_common.h"
 #include "game/scene.h"
 
-void UIQuoridor_emptyFile()
+/// @brief Commence l'enregistrement de la partie courante dans #FILE_TO_SAVE_GAME.
+/// À appeler sur la position de départ, avant le premier tour.
+static void UIQuoridor_startRecord(UIQuoridor *self)
 {
-	FILE* file = fopen(FILE_TO_SAVE_GAME, "w+");
-	if (file == NULL) return;
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
 
-	fprintf(file, "%d\n", 0);
+    // Le fichier ne contient que la partie courante : il est vidé à chaque nouvelle partie.
+    QuoridorRecordWriter_destroy(self->m_recordWriter);
+    self->m_recordWriter = QuoridorRecordWriter_create(FILE_TO_SAVE_GAME, false);
+    if (self->m_recordWriter == NULL) return;
 
-	fclose(file);
+    QuoridorRecordHeader header;
+    QuoridorRecordHeader_init(&header, core, UIList_getSelected(self->m_listMode));
+    QuoridorRecordWriter_beginGame(self->m_recordWriter, &header);
 }
 
 void UIQuoridor_saveTurnInFile(UIQuoridor* self, QuoridorTurn* turn) 
 {
-    
-    QuoridorCore* core = Scene_getQuoridorCore(self->m_scene);
-
-    FILE* file = fopen(FILE_TO_SAVE_GAME, "a");
-    fprintf(file, "%d %d %d %d %d\n", core->playerID, turn->i, turn->j, UIList_getSelected(self->m_listMode), turn->action);
-    fclose(file);
+    if (self->m_recordWriter == NULL) return;
 
+    QuoridorCore* core = Scene_getQuoridorCore(self->m_scene);
+    QuoridorRecordWriter_addTurn(self->m_recordWriter, *turn);
+    if (core->state != QUORIDOR_STATE_IN_PROGRESS)
+    {
+        QuoridorRecordWriter_endGame(self->m_recordWriter, core->state);
+    }
 }
 
 static bool UIQuoridor_isPlayerTurn(UIQuoridor *self)
@@ -46,28 +53,24 @@ static int UIQuoridor_calculateScore(float score1, float score2)
     return 1;
 }
 
+/// @brief Interrompt le calcul éventuel du coup de l'IA.
+static void UIQuoridor_cancelAI(UIQuoridor *self)
+{
+    AIService_cancel(self->m_aiService);
+    self->m_aiPending = false;
+    self->m_aiAccu = 0;
+    self->m_aiTurn.action = QUORIDOR_ACTION_UNDEFINED;
+}
+
 static void UIQoridor_resetTempAction(UIQuoridor *self)
 {
 	assert(self && "The UIQuoridor must be created");
 
 	QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
 	if (core->state != QUORIDOR_STATE_IN_PROGRESS) return;
-    
-    for (int i = 0; i < core->gridSize; i++)
-    {
-        for (int j = 0; j < core->gridSize; j++)
-        {
-            if (core->vWalls[i][j] == WALL_STATE_TEMP)
-            {
-                core->vWalls[i][j] = WALL_STATE_NONE;
-            }
-            if (core->hWalls[i][j] == WALL_STATE_TEMP)
-            {
-                core->hWalls[i][j] = WALL_STATE_NONE;
-            }
-            core->reviewCore[i][j] = 0;
-        }
-    }
+
+    self->m_reviewTurn.action = QUORIDOR_ACTION_UNDEFINED;
+    memset(self->m_reviewCells, 0, sizeof(self->m_reviewCells));
 }
 
 void UIQuoridor_nextTurn(UIQuoridor *self) 
@@ -78,50 +81,31 @@ void UIQuoridor_nextTurn(UIQuoridor *self)
     if (core->state != QUORIDOR_STATE_IN_PROGRESS) return;
    
     UIQoridor_resetTempAction(self); // On reset les actions temporaires
+    self->m_reviewWaiting = false;
 
     // On récupère l'action qui est à faire
-    FILE* file = fopen(FILE_TO_SAVE_GAME, "r+");
-	if (file == NULL) return;
-    QuoridorTurn* turn = malloc(sizeof(QuoridorTurn));
-
-    int playerID = -1;
-    int isIA = -1;
-
-    int round;
-    fscanf(file, "%d", &round);
-    printf("%d\n", round);
-    int end;
-    for (int i = -1; i < round; i++) {
-        end = fscanf(file, "%d %d %d %d %d", &playerID, &turn->i, &turn->j, &isIA, &turn->action);
-    }
-    if (end == EOF) {
+    if (self->m_reviewPly >= self->m_recordIndex.turnCount)
+    {
         core->state = QUORIDOR_STATE_UNFINISHED;
         return;
     }
-    
-    
-    // On éxécute le mouvement
-	self->m_listMode->m_valueID = isIA;
-
-
-    int selectedMode = UIList_getSelected(self->m_listMode);
-    int isIaTurn = ((selectedMode == 0) || ((selectedMode == 1) && core->playerID == 0));
 
-    // On veut voir quel coup est le meilleur
-    QuoridorTurn bestTurn;
-    bestTurn = QuoridorCore_computeTurn(core, 6, self->m_aiData[core->playerID]);
-
-    // Score du joueur
-    QuoridorCore gameCopy = *core;
-    QuoridorCore_playTurn(&gameCopy, *turn);
-    float scorePlayer = QuoridorCore_computeScore(&gameCopy, core->playerID, *turn);
-
-    // Score de l'IA
-    gameCopy = *core;
-    QuoridorCore_playTurn(&gameCopy, bestTurn);
-    float scoreIA = QuoridorCore_computeScore(&gameCopy, core->playerID, bestTurn);
+    // On veut voir quel coup est le meilleur.
+    // Les tours sont analysés en arrière-plan : si celui-ci ne l'est pas encore, il passe en
+    // priorité et UIQuoridor_updatePageReview() rappelle cette fonction dès qu'il est prêt.
+    AIPlyAnalysis analysis;
+    if (AIAnalysis_getResult(self->m_analysis, self->m_reviewPly, &analysis) == false)
+    {
+        AIAnalysis_prioritize(self->m_analysis, self->m_reviewPly);
+        self->m_reviewWaiting = true;
+        Text_setString(self->m_textTurnInfo, "Analyse...");
+        return;
+    }
+    const QuoridorTurn *turn = &self->m_recordIndex.turns[self->m_reviewPly++];
 
-    printf("======= INFORMATIONS SUR LE COUP =======\nLe type de coup est : %d\nLes coordonnées sont: %d\nLe score du coup est: %f VS %f\nAvis sur le coup: %d\n\n", bestTurn.action == turn->action, (bestTurn.i == turn->i) && (bestTurn.j == turn->j), scorePlayer, scoreIA, UIQuoridor_calculateScore(scorePlayer, scoreIA));
+    QuoridorTurn bestTurn = analysis.bestTurn;
+    float scorePlayer = analysis.playedScore;
+    float scoreIA = analysis.bestScore;
 
     // Score du coup
     int score = UIQuoridor_calculateScore(scorePlayer, scoreIA);
@@ -147,29 +131,21 @@ void UIQuoridor_nextTurn(UIQuoridor *self)
     // PAS CALCULER L'AVANCE
 
     if (bestTurn.action == QUORIDOR_MOVE_TO) {
-        core->reviewCore[bestTurn.i][bestTurn.j] = 2;
-        core->reviewCore[core->positions[core->playerID].i][core->positions[core->playerID].j] = 1;
+        self->m_reviewCells[bestTurn.i][bestTurn.j] = 2;
+        self->m_reviewCells[core->positions[core->playerID].i][core->positions[core->playerID].j] = 1;
     }
 
     QuoridorCore_playTurn(core, *turn);
 
     if (score <= 2 && !(bestTurn.i == turn->i && bestTurn.j == turn->j && bestTurn.action == turn->action))
     {
-        if (bestTurn.action == QUORIDOR_PLAY_HORIZONTAL_WALL) {
-            QuoridorCore_playWall(core, WALL_TYPE_HORIZONTAL_TEMP, bestTurn.i, bestTurn.j);
-        }
-        else if (bestTurn.action == QUORIDOR_PLAY_VERTICAL_WALL) {
-            QuoridorCore_playWall(core, WALL_TYPE_VERTICAL_TEMP, bestTurn.i, bestTurn.j);
+        if (bestTurn.action == QUORIDOR_PLAY_HORIZONTAL_WALL || bestTurn.action == QUORIDOR_PLAY_VERTICAL_WALL) {
+            self->m_reviewTurn = bestTurn;
         }
 
     }
 
 
-    // On ferme les fichiers
-    rewind(file);
-    fprintf(file, "%d", round + 1);
-	fclose(file);
-    free(turn);
 }
 
 void UIQuoridor_updateTurn(UIQuoridor *self)
@@ -188,17 +164,43 @@ void UIQuoridor_updateTurn(UIQuoridor *self)
         // Tour de l'IA
         if (self->m_aiTurn.action == QUORIDOR_ACTION_UNDEFINED)
         {
-            self->m_aiAccu = 0;
-            int depth = 1;
-            switch (UIList_getSelected(self->m_listLevel))
+            if (self->m_aiPending == false)
             {
-            default:
-            case 0: depth = 2; break;
-            case 1: depth = 3; break;
-            case 2: depth = 5; break;
+                AISearchParams params = { 0 };
+                params.depth = 1;
+                switch (UIList_getSelected(self->m_listLevel))
+                {
+                default:
+                case 0: params.depth = 2; break;
+                case 1: params.depth = 3; break;
+                case 2: params.depth = 5; break;
+                case 3: params.budgetMS = 1000; break;
+                case 4: params.engine = AI_ENGINE_MCTS; params.budgetMS = 1000; break;
+                }
+                // Les niveaux à profondeur fixe restent séquentiels (et donc reproductibles) :
+                // seuls les niveaux limités en temps profitent de la recherche parallèle.
+                params.threadCount = (params.budgetMS > 0) ? SDL_GetNumLogicalCPUCores() : 1;
+                params.parallelMode = AI_PARALLEL_LAZY_SMP;
+                // Seuls les niveaux limités en temps lisent les analyses enregistrées :
+                // les niveaux à profondeur fixe ne doivent pas jouer mieux que leur profondeur.
+                if (params.engine == AI_ENGINE_MINMAX && params.budgetMS > 0)
+                    params.cache = self->m_aiCache;
+                params.book = self->m_book;
+
+                // La recherche est exécutée sur le thread du service,
+                // le résultat est récupéré lors des frames suivantes.
+                AIService_request(self->m_aiService, core, &params, self->m_aiData[core->playerID]);
+                self->m_aiPending = true;
+                self->m_aiAccu = 0;
+            }
+            else
+            {
+                self->m_aiAccu += Timer_getDeltaMS(g_time);
+                if (AIService_poll(self->m_aiService, &self->m_aiTurn))
+                {
+                    self->m_aiPending = false;
+                }
             }
-
-            self->m_aiTurn = QuoridorCore_computeTurn(core, depth, self->m_aiData[core->playerID]);
         }
         else
         {
@@ -348,10 +350,9 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
     UIQuoridor *self = (UIQuoridor *)calloc(1, sizeof(UIQuoridor));
     AssertNew(self);
 
-	UIQuoridor_emptyFile(); // On vide le dossier de sauvegarde
-
     self->m_scene = scene;
     self->m_aiTurn.action = QUORIDOR_ACTION_UNDEFINED;
+    self->m_reviewTurn.action = QUORIDOR_ACTION_UNDEFINED;
 
     QuoridorCore *core = Scene_getQuoridorCore(scene);
     for (int i = 0; i < 2; i++)
@@ -359,6 +360,9 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
         //self->m_aiData[i] = NULL;
         self->m_aiData[i] = AIData_create(core);
     }
+    self->m_aiService = AIService_create();
+    self->m_aiCache = AICache_create(FILE_ANALYSIS_CACHE);
+    self->m_book = QuoridorBook_create(FILE_OPENING_BOOK);
 
     AssetManager *assets = Scene_getAssetManager(scene);
     TTF_Font *font = NULL;
@@ -379,7 +383,7 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
 #endif
 
 
-    const char *levelValues[] = { "easy", "medium", "hard" };
+    const char *levelValues[] = { "easy", "medium", "hard", "expert", "MCTS" };
     self->m_listLevel = UIList_create(
         scene, rect, 0.5f, font,
         "CPU Level", levelValues, sizeof(levelValues) / sizeof(char *),
@@ -444,6 +448,10 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
         scene, rect, font, "Next",
         g_colors.white, g_colors.cell, g_colors.selected
     );
+    self->m_buttonPrevStep = UIButton_create(
+        scene, rect, font, "Prev",
+        g_colors.white, g_colors.cell, g_colors.selected
+    );
     self->m_buttonBack = UIButton_create(
         scene, rect, font, "Back",
         g_colors.white, g_colors.cell, g_colors.selected
@@ -455,11 +463,13 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
     self->m_textTitleWalls = Text_create(g_renderer, font, "Walls", g_colors.white);
     self->m_textTitleDistances = Text_create(g_renderer, font, "Distances", g_colors.white);
     self->m_textTitleTurnInfo = Text_create(g_renderer, font, "Avis sur le coup", g_colors.white);
+    self->m_textTitleAnalysis = Text_create(g_renderer, font, "Analysis", g_colors.white);
 
     font = AssetManager_getFont(assets, FONT_BIG);
     self->m_textTitleSettings = Text_create(g_renderer, font, "Settings", g_colors.player0);
     self->m_textInfo = Text_create(g_renderer, font, "P1 turn", g_colors.player0);
     self->m_textTurnInfo = Text_create(g_renderer, font, "--", g_colors.player0);
+    self->m_textAnalysis = Text_create(g_renderer, font, "--", g_colors.white);
     self->m_textWalls[0] = Text_create(g_renderer, font, "10", g_colors.player0);
     self->m_textWalls[1] = Text_create(g_renderer, font, "10", g_colors.player1);
     self->m_textDistances[0] = Text_create(g_renderer, font, "10", g_colors.player0);
@@ -468,6 +478,8 @@ UIQuoridor *UIQuoridor_create(Scene *scene)
     // Calcule les positions des rectangles/boutons/listes
     UIQuoridor_updateRects(self);
 
+    UIQuoridor_startRecord(self);
+
     return self;
 }
 
@@ -475,22 +487,35 @@ void UIQuoridor_destroy(UIQuoridor *self)
 {
     if (!self) return;
 
+    // Le service doit être arrêté avant la destruction des données de l'IA,
+    // l'analyse avant celle de la partie relue, les deux avant la fermeture du cache et du livre.
+    AIService_destroy(self->m_aiService);
+    AIAnalysis_destroy(self->m_analysis);
+    AICache_destroy(self->m_aiCache);
+    QuoridorBook_destroy(self->m_book);
+
     for (int i = 0; i < 2; i++)
     {
         AIData_destroy(self->m_aiData[i]);
     }
 
+    QuoridorRecordWriter_destroy(self->m_recordWriter);
+    QuoridorRecordIndex_clear(&self->m_recordIndex);
+    QuoridorRecord_clear(&self->m_record);
+
     Text_destroy(self->m_textTitleInfo);
     Text_destroy(self->m_textTitleWalls);
     Text_destroy(self->m_textTitleDistances);
     Text_destroy(self->m_textTitleSettings);
     Text_destroy(self->m_textTitleTurnInfo);
+    Text_destroy(self->m_textTitleAnalysis);
     Text_destroy(self->m_textWalls[0]);
     Text_destroy(self->m_textWalls[1]);
     Text_destroy(self->m_textDistances[0]);
     Text_destroy(self->m_textDistances[1]);
     Text_destroy(self->m_textInfo);
     Text_destroy(self->m_textTurnInfo);
+    Text_destroy(self->m_textAnalysis);
 
     UIList_destroy(self->m_listMode);
     UIList_destroy(self->m_listLevel);
@@ -503,6 +528,7 @@ void UIQuoridor_destroy(UIQuoridor *self)
     UIButton_destroy(self->m_buttonRestart);
     UIButton_destroy(self->m_buttonReview);
     UIButton_destroy(self->m_buttonNextStep);
+    UIButton_destroy(self->m_buttonPrevStep);
     UIButton_destroy(self->m_buttonExit);
     UIButton_destroy(self->m_buttonBack);
 
@@ -541,16 +567,15 @@ void UIQuoridor_updatePageMain(UIQuoridor *self)
 
     if (UIButton_isPressed(self->m_buttonSettings))
     {
+        UIQuoridor_cancelAI(self);
         self->m_inSettings = true;
     }
     else if (UIButton_isPressed(self->m_buttonRestart))
     {
-        UIQuoridor_emptyFile(); // On vide le dossier de sauvegarde
         UIQuoridor_restartQuoridor(self);
     }
     else if (UIButton_isPressed(self->m_buttonReview)) {
-        UIQuoridor_restartQuoridor(self);
-        self->m_inReview = true;
+        UIQuoridor_startReview(self);
     }
     else {
         UIQuoridor_updateTurn(self);
@@ -562,10 +587,7 @@ void UIQuoridor_updatePageMain(UIQuoridor *self)
         sprintf(buffer, "%d", core->wallCounts[i]);
         Text_setString(self->m_textWalls[i], buffer);
 
-        QuoridorPos path[MAX_PATH_LEN];
-        int size = 0;
-        QuoridorCore_getShortestPath(core, i, path, &size);
-        sprintf(buffer, "%d", size - 1);
+        sprintf(buffer, "%d", QuoridorCore_getPathLength(core, i));
         Text_setString(self->m_textDistances[i], buffer);
     }
 
@@ -603,18 +625,44 @@ void UIQuoridor_updatePageReview(UIQuoridor* self)
 
     UIButton_update(self->m_buttonExit);
     UIButton_update(self->m_buttonNextStep);
+    UIButton_update(self->m_buttonPrevStep);
 
     if (UIButton_isPressed(self->m_buttonExit))
     {
+        AIAnalysis_destroy(self->m_analysis);
+        self->m_analysis = NULL;
+        self->m_reviewWaiting = false;
         self->m_inReview = false;
-		UIQuoridor_emptyFile(); // On vide le dossier de sauvegarde
         UIQuoridor_restartQuoridor(self);
+        return;
 
     }
     else if (UIButton_isPressed(self->m_buttonNextStep))
     {
         UIQuoridor_nextTurn(self);
     }
+    else if (UIButton_isPressed(self->m_buttonPrevStep))
+    {
+        UIQuoridor_seekTurn(self, self->m_reviewPly - 1);
+    }
+    else if (self->m_reviewWaiting)
+    {
+        UIQuoridor_nextTurn(self);
+    }
+
+    const int doneCount = AIAnalysis_getDoneCount(self->m_analysis);
+    if (doneCount != self->m_analysisShown)
+    {
+        const int plyCount = AIAnalysis_getPlyCount(self->m_analysis);
+        char progress[64] = { 0 };
+        sprintf(progress, "%d / %d", doneCount, plyCount);
+        Text_setString(self->m_textAnalysis, progress);
+        self->m_analysisShown = doneCount;
+
+        // Analyse terminée : ses résultats sont écrits dans le fichier sans attendre la fermeture du jeu.
+        if (doneCount == plyCount && self->m_aiCache)
+            AICache_flush(self->m_aiCache);
+    }
 
     char buffer[128] = { 0 };
     for (int i = 0; i < 2; i++)
@@ -622,10 +670,7 @@ void UIQuoridor_updatePageReview(UIQuoridor* self)
         sprintf(buffer, "%d", core->wallCounts[i]);
         Text_setString(self->m_textWalls[i], buffer);
 
-        QuoridorPos path[MAX_PATH_LEN];
-        int size = 0;
-        QuoridorCore_getShortestPath(core, i, path, &size);
-        sprintf(buffer, "%d", size - 1);
+        sprintf(buffer, "%d", QuoridorCore_getPathLength(core, i));
         Text_setString(self->m_textDistances[i], buffer);
     }
 
@@ -678,8 +723,7 @@ void UIQuoridor_updatePageSettings(UIQuoridor *self)
     int currId = self->m_listMode->m_valueID;
     if (currId != prevId)
     {
-        self->m_aiAccu = 0;
-        self->m_aiTurn.action = QUORIDOR_ACTION_UNDEFINED;
+        UIQuoridor_cancelAI(self);
     }
 
     if (UIButton_isPressed(self->m_buttonBack))
@@ -721,13 +765,98 @@ void UIQuoridor_restartQuoridor(UIQuoridor *self)
         QuoridorCore_randomStart(core);
     }
 
+    // La recherche en cours utilise les données de l'IA : elle est interrompue avant leur réinitialisation.
+    UIQuoridor_cancelAI(self);
     for (int i = 0; i < 2; i++)
     {
-        AIData_reset(self->m_aiData);
+        AIData_reset(self->m_aiData[i]);
     }
 
-    self->m_aiTurn.action = QUORIDOR_ACTION_UNDEFINED;
+    self->m_reviewTurn.action = QUORIDOR_ACTION_UNDEFINED;
+    memset(self->m_reviewCells, 0, sizeof(self->m_reviewCells));
+    self->m_reviewFailed = false;
     UIQuoridor_updateRects(self);
+
+    UIQuoridor_startRecord(self);
+}
+
+void UIQuoridor_startReview(UIQuoridor *self)
+{
+    assert(self && "The UIQuoridor must be created");
+
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+
+    // L'analyse précédente lit la partie relue : elle est arrêtée avant que celle-ci soit remplacée.
+    AIAnalysis_destroy(self->m_analysis);
+    self->m_analysis = NULL;
+
+    // La partie est relue dans le fichier : les tours en attente y sont d'abord écrits.
+    if (self->m_recordWriter)
+    {
+        QuoridorRecordWriter_flush(self->m_recordWriter);
+    }
+
+    QuoridorRecordReader *reader = QuoridorRecordReader_create(FILE_TO_SAVE_GAME);
+    bool loaded = reader && QuoridorRecordReader_next(reader, &self->m_record);
+    QuoridorRecordReader_destroy(reader);
+
+    // Les positions de la partie sont indexées une fois pour toutes : Next, Prev et
+    // UIQuoridor_seekTurn() ne relisent plus le fichier.
+    loaded = loaded && QuoridorRecordIndex_build(&self->m_recordIndex, &self->m_record);
+    if (loaded == false)
+    {
+        // Le message reste affiché sur la page principale jusqu'à la prochaine partie.
+        Text_setString(self->m_textTurnInfo, "Partie illisible");
+        Text_setColor(self->m_textTurnInfo, g_colors.red);
+        self->m_reviewFailed = true;
+        return;
+    }
+    self->m_reviewFailed = false;
+    Text_setString(self->m_textTurnInfo, "--");
+    Text_setColor(self->m_textTurnInfo, g_colors.player0);
+
+    UIQuoridor_cancelAI(self);
+    QuoridorRecordIndex_getPosition(&self->m_recordIndex, 0, core);
+    self->m_listMode->m_valueID = self->m_record.header.tag;
+    self->m_reviewPly = 0;
+    self->m_reviewWaiting = false;
+
+    // Analyse profonde de tous les tours, répartie sur tous les coeurs (une recherche par coeur).
+    // Les positions déjà analysées (partie déjà relue, ouverture commune) sont lues dans le cache.
+    AISearchParams params = { 0 };
+    params.depth = 6;
+    params.cache = self->m_aiCache;
+    self->m_analysis = AIAnalysis_create(&self->m_recordIndex, &params, SDL_GetNumLogicalCPUCores());
+    self->m_analysisShown = -1;
+
+    for (int i = 0; i < 2; i++)
+    {
+        AIData_reset(self->m_aiData[i]);
+    }
+
+    self->m_reviewTurn.action = QUORIDOR_ACTION_UNDEFINED;
+    memset(self->m_reviewCells, 0, sizeof(self->m_reviewCells));
+    UIQuoridor_updateRects(self);
+    self->m_inReview = true;
+}
+
+void UIQuoridor_seekTurn(UIQuoridor *self, int ply)
+{
+    assert(self && "The UIQuoridor must be created");
+
+    if (self->m_recordIndex.snapshots == NULL) return;
+    if (ply < 0) ply = 0;
+    if (ply > self->m_recordIndex.turnCount) ply = self->m_recordIndex.turnCount;
+
+    QuoridorCore *core = Scene_getQuoridorCore(self->m_scene);
+    QuoridorRecordIndex_getPosition(&self->m_recordIndex, ply, core);
+    self->m_reviewPly = ply;
+    self->m_reviewWaiting = false;
+    AIAnalysis_prioritize(self->m_analysis, ply);
+
+    self->m_reviewTurn.action = QUORIDOR_ACTION_UNDEFINED;
+    memset(self->m_reviewCells, 0, sizeof(self->m_reviewCells));
+    Text_setString(self->m_textTurnInfo, "--");
 }
 
 void UIQuoridor_updateRects(UIQuoridor *self)
@@ -760,11 +889,12 @@ void UIQuoridor_updateRects(UIQuoridor *self)
 
     rect.x += roundf(rect.w + 0.2f * scale);
     UIButton_setRect(self->m_buttonRestart, rect);
-    UIButton_setRect(self->m_buttonNextStep, rect);
+    UIButton_setRect(self->m_buttonPrevStep, rect);
 
 
     rect.x += roundf(rect.w + 0.2f * scale);
     UIButton_setRect(self->m_buttonReview, rect);
+    UIButton_setRect(self->m_buttonNextStep, rect);
 
 
     const float labelRatio = 0.4f;
@@ -888,12 +1018,12 @@ void UIQuoridor_renderBoard(UIQuoridor *self)
         {
             SDL_FRect rect = self->m_rectCells[i][j];
 
-            if(core->reviewCore[i][j] == 1)
+            if(self->m_reviewCells[i][j] == 1)
 			{
 				Game_setRenderDrawColor((core->playerID == 0) ? g_colors.player1 : g_colors.player0, 100);
 				SDL_RenderFillRect(g_renderer, &rect);
 			}
-			else if(core->reviewCore[i][j] == 2)
+			else if(self->m_reviewCells[i][j] == 2)
 			{
 				Game_setRenderDrawColor(g_colors.green, 50);
 				SDL_RenderFillRect(g_renderer, &rect);
@@ -927,21 +1057,26 @@ void UIQuoridor_renderBoard(UIQuoridor *self)
     {
         for (int j = 0; j < gridSize - 1; j++)
         {
+            const bool hReview = (self->m_reviewTurn.action == QUORIDOR_PLAY_HORIZONTAL_WALL)
+                && (self->m_reviewTurn.i == i) && (self->m_reviewTurn.j == j);
+            const bool vReview = (self->m_reviewTurn.action == QUORIDOR_PLAY_VERTICAL_WALL)
+                && (self->m_reviewTurn.i == i) && (self->m_reviewTurn.j == j);
+
             bool mouseInRect = FRect_containsPoint(&(self->m_rectMouseHWalls[i][j]), mousePos);
-            if (core->hWalls[i][j] == WALL_STATE_START)
+            if (QuoridorCore_getWallState(core, WALL_TYPE_HORIZONTAL, i, j) == WALL_STATE_START)
             {
                 Game_setRenderDrawColor(g_colors.wall, 255);
 #if DEBUG
                 SDL_Color wall_player0 = { 255,  69,   0, 255 }; // OrangeRed (#FF4500)
                 SDL_Color wall_player1 = { 255,   0,  0, 255 }; // Red-violet foncé (#800040)
 
-                int owner = core->hWallOwners[i][j];
+                int owner = QuoridorMask_test(core->hWallOwners, i * MAX_GRID_SIZE + j);
                 SDL_Color color = (owner == 0) ? wall_player0 : wall_player1;
                 Game_setRenderDrawColor(color, 255);
 #endif
                 SDL_RenderFillRect(g_renderer, &(self->m_rectHWalls[i][j]));
             }
-            else if (core->hWalls[i][j] == WALL_STATE_TEMP) {
+            else if (hReview) {
                 Game_setRenderDrawColor(g_colors.green, 100);
                 SDL_RenderFillRect(g_renderer, &(self->m_rectHWalls[i][j]));
             }
@@ -960,20 +1095,20 @@ void UIQuoridor_renderBoard(UIQuoridor *self)
             }
 
             mouseInRect = FRect_containsPoint(&(self->m_rectMouseVWalls[i][j]), mousePos);
-            if (core->vWalls[i][j] == WALL_STATE_START)
+            if (QuoridorCore_getWallState(core, WALL_TYPE_VERTICAL, i, j) == WALL_STATE_START)
             {
                 Game_setRenderDrawColor(g_colors.wall, 255);
 #if DEBUG
                 SDL_Color wall_player0 = { 255,  69,   0, 255 }; // OrangeRed (#FF4500)
                 SDL_Color wall_player1 = { 255,   0,  0, 255 }; // Red-violet foncé (#800040)
 
-                int owner = core->vWallOwners[i][j];
+                int owner = QuoridorMask_test(core->vWallOwners, i * MAX_GRID_SIZE + j);
                 SDL_Color color = (owner == 0) ? wall_player0 : wall_player1;
                 Game_setRenderDrawColor(color, 255);
 #endif
                 SDL_RenderFillRect(g_renderer, &(self->m_rectVWalls[i][j]));
             }
-            else if (core->vWalls[i][j] == WALL_STATE_TEMP) {
+            else if (vReview) {
                 Game_setRenderDrawColor(g_colors.green, 100);
                 SDL_RenderFillRect(g_renderer, &(self->m_rectVWalls[i][j]));
             }
@@ -1059,6 +1194,17 @@ void UIQuoridor_renderPageMain(UIQuoridor *self)
             self->m_textTitleDistances,
             self->m_textDistances, 2
         );
+
+        if (self->m_reviewFailed)
+        {
+            y += blockSep;
+
+            y = UIQuoridor_renderPanel(
+                self, x, y, panelWidth,
+                self->m_textTitleTurnInfo,
+                &(self->m_textTurnInfo), 1
+            );
+        }
     }
 }
 
@@ -1074,6 +1220,7 @@ void UIQuoridor_renderPageReview(UIQuoridor* self)
     // UIButtons*
     UIButton_render(self->m_buttonExit);
     if(core->state != QUORIDOR_STATE_UNFINISHED) UIButton_render(self->m_buttonNextStep);
+    if (self->m_reviewPly > 0) UIButton_render(self->m_buttonPrevStep);
 
     // Panels
     const float blockSep = 20.f;
@@ -1104,7 +1251,13 @@ void UIQuoridor_renderPageReview(UIQuoridor* self)
         self->m_textDistances, 2
     );
 
+    y += blockSep;
 
+    y = UIQuoridor_renderPanel(
+        self, x, y, panelWidth,
+        self->m_textTitleAnalysis,
+        &(self->m_textAnalysis), 1
+    );
 
     int selectedMode = UIList_getSelected(self->m_listMode);
     if ( (selectedMode == 0) || ((selectedMode == 1) && core->playerID^1 == 0) ) {
@@ -9,6 +9,9 @@
 #include "settings.h"
 #include "core/quoridor_core.h"
 #include "core/quoridor_ai.h"
+#include "core/quoridor_ai_service.h"
+#include "core/quoridor_ai_analysis.h"
+#include "core/quoridor_record.h"
 #include "engine/text.h"
 #include "game/ui_button.h"
 #include "game/ui_list.h"
@@ -31,6 +34,8 @@ typedef struct UIQuoridor
     Text *m_textInfo;
     Text *m_textTitleTurnInfo;
     Text *m_textTurnInfo;
+    Text *m_textTitleAnalysis;
+    Text *m_textAnalysis;
     Text *m_textTitleWalls;
     Text *m_textWalls[2];
     Text *m_textTitleDistances;
@@ -42,6 +47,7 @@ typedef struct UIQuoridor
     UIButton *m_buttonReview;
     UIButton *m_buttonExit;
     UIButton *m_buttonNextStep;
+    UIButton *m_buttonPrevStep;
     UIButton *m_buttonBack;
 
     UIList *m_listMode;
@@ -57,12 +63,56 @@ typedef struct UIQuoridor
     QuoridorTurn m_aiTurn;
     void *m_aiData[2];
 
+    /// @brief Service calculant les coups de l'IA sans bloquer l'affichage.
+    AIService *m_aiService;
+
+    /// @brief Indique si un coup de l'IA est en cours de calcul.
+    bool m_aiPending;
+
+    /// @brief Analyses persistantes (#FILE_ANALYSIS_CACHE) partagées par toutes les recherches (NULL si le fichier ne peut pas être ouvert).
+    AICache *m_aiCache;
+
+    /// @brief Livre d'ouvertures (#FILE_OPENING_BOOK) projeté en lecture seule (NULL si le fichier est absent).
+    QuoridorBook *m_book;
+
+    /// @brief Etat des cases en mode Review.
+    /// 0 : case vide
+    /// 1 : Ancienne position
+    /// 2 : Position idéale
+    int m_reviewCells[MAX_GRID_SIZE][MAX_GRID_SIZE];
+
+    /// @brief Meilleur mur proposé par l'IA en mode Review (affiché en transparence).
+    QuoridorTurn m_reviewTurn;
+
+    /// @brief Enregistrement de la partie courante dans #FILE_TO_SAVE_GAME (NULL si le fichier ne peut pas être ouvert).
+    QuoridorRecordWriter *m_recordWriter;
+
+    /// @brief Partie relue en mode Review et index de ses positions.
+    QuoridorRecord m_record;
+    QuoridorRecordIndex m_recordIndex;
+
+    /// @brief Nombre de tours rejoués en mode Review (indice du prochain tour).
+    int m_reviewPly;
+
+    /// @brief Analyse en arrière-plan de tous les tours de la partie relue (NULL hors du mode Review).
+    AIAnalysis *m_analysis;
+
+    /// @brief Indique que Next attend la fin de l'analyse du prochain tour.
+    bool m_reviewWaiting;
+
+    /// @brief Indique que la partie enregistrée n'a pas pu être relue (message dans m_textTurnInfo).
+    bool m_reviewFailed;
+
+    /// @brief Nombre de tours analysés affiché dans le panneau Analysis.
+    int m_analysisShown;
+
     Uint64 m_aiAccu;
 } UIQuoridor;
 
-/// @brief Enregistre les coups � faire dans un fichier text #FILE_TO_SAVE_GAME
+/// @brief Ajoute un tour à la partie enregistrée dans #FILE_TO_SAVE_GAME (voir core/quoridor_record.h).
+/// À appeler juste après avoir joué le tour.
 /// @param self Instance du jeu.
-/// @param turn Tour � sauvegarder.
+/// @param turn Tour joué.
 void UIQuoridor_saveTurnInFile(UIQuoridor *self, QuoridorTurn *turn);
 
 UIQuoridor *UIQuoridor_create(Scene *scene);
@@ -74,9 +124,18 @@ void UIQuoridor_updatePageReview(UIQuoridor *self);
 void UIQuoridor_updatePageSettings(UIQuoridor *self);
 void UIQuoridor_updateTurn(UIQuoridor *self);
 
-void UIQuoridor_emptyFile();
 void UIQuoridor_restartQuoridor(UIQuoridor *self);
 
+/// @brief Passe en mode Review : la partie enregistrée est relue puis rejouée depuis sa position de départ.
+/// L'analyse de tous ses tours démarre en arrière-plan (voir AIAnalysis).
+void UIQuoridor_startReview(UIQuoridor *self);
+
+/// @brief Place le plateau dans la position de la partie relue après un nombre de tours donné
+/// (en temps constant, voir QuoridorRecordIndex).
+/// @param self Instance du jeu.
+/// @param ply Nombre de tours joués depuis la position de départ (ramené entre 0 et le nombre de tours de la partie).
+void UIQuoridor_seekTurn(UIQuoridor *self, int ply);
+
 void UIQuoridor_render(UIQuoridor *self);
 void UIQuoridor_renderPageMain(UIQuoridor *self);
 void UIQuoridor_renderPageSettings(UIQuoridor *self);
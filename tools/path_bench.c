@@ -0,0 +1,171 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+// Microbenchmark des algorithmes de plus court chemin (voir core/quoridor_path.h).
+// Pour chaque taille de grille, des plateaux aléatoires sont générés en posant des murs légaux
+// et en déplaçant les pions, puis chaque algorithme calcule les chemins des deux joueurs sur tous ces plateaux.
+//
+// Utilisation : path_bench [nombre de plateaux] [nombre de répétitions]
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_path.h"
+
+#define DEFAULT_BOARD_COUNT 1000
+#define DEFAULT_REPEAT_COUNT 20
+
+/// @brief Joue un tour aléatoire (un mur avec une probabilité de 1/2 s'il en reste, sinon un déplacement).
+static void PathBench_playRandomTurn(QuoridorCore *core)
+{
+    QuoridorMask hMask, vMask;
+    QuoridorCore_generateLegalWalls(core, &hMask, &vMask);
+    const int wallCount = QuoridorMask_popCount(hMask) + QuoridorMask_popCount(vMask);
+
+    if (wallCount > 0 && rand() % 2)
+    {
+        int index = rand() % wallCount;
+        WallType type = WALL_TYPE_HORIZONTAL;
+        QuoridorMask mask = hMask;
+        if (index >= QuoridorMask_popCount(hMask))
+        {
+            index -= QuoridorMask_popCount(hMask);
+            type = WALL_TYPE_VERTICAL;
+            mask = vMask;
+        }
+
+        int k = QuoridorMask_popLSB(&mask);
+        for (; index > 0; index--)
+            k = QuoridorMask_popLSB(&mask);
+
+        QuoridorCore_playWall(core, type, k / MAX_GRID_SIZE, k % MAX_GRID_SIZE);
+        return;
+    }
+
+    QuoridorPos moves[QUORIDOR_MOVE_COUNT];
+    int moveCount = 0;
+    const QuoridorPos pos = core->positions[core->playerID];
+    for (int m = 0; m < QUORIDOR_MOVE_COUNT; m++)
+    {
+        if ((core->validMoves >> m) & 1)
+        {
+            QuoridorPos offset = QuoridorCore_getMoveOffset(m);
+            moves[moveCount].i = pos.i + offset.i;
+            moves[moveCount].j = pos.j + offset.j;
+            moveCount++;
+        }
+    }
+    assert(moveCount > 0);
+
+    const QuoridorPos move = moves[rand() % moveCount];
+    QuoridorCore_moveTo(core, move.i, move.j);
+}
+
+/// @brief Génère un plateau aléatoire dont la partie est toujours en cours.
+static void PathBench_randomBoard(QuoridorCore *core, int gridSize)
+{
+    const int wallCount = (gridSize == 9) ? 10 : gridSize + 1;
+    const int turnCount = rand() % (4 * wallCount + 1);
+
+    do
+    {
+        QuoridorCore_reset(core, gridSize, wallCount, rand() % 2);
+        for (int t = 0; t < turnCount && core->state == QUORIDOR_STATE_IN_PROGRESS; t++)
+            PathBench_playRandomTurn(core);
+    } while (core->state != QUORIDOR_STATE_IN_PROGRESS);
+}
+
+int main(int argc, char *argv[])
+{
+    const int boardCount = (argc > 1) ? atoi(argv[1]) : DEFAULT_BOARD_COUNT;
+    const int repeatCount = (argc > 2) ? atoi(argv[2]) : DEFAULT_REPEAT_COUNT;
+    if (boardCount <= 0 || repeatCount <= 0)
+    {
+        printf("Usage: %s [board count] [repeat count]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    QuoridorCore *boards = (QuoridorCore *)calloc(boardCount, sizeof(QuoridorCore));
+    AssertNew(boards);
+
+    const double frequency = (double)SDL_GetPerformanceFrequency();
+    srand(1);
+
+    printf("%d boards, %d repetitions (ns per path)\n", boardCount, repeatCount);
+    printf("%-6s", "grid");
+    for (int e = 0; e < QUORIDOR_PATH_ENGINE_COUNT; e++)
+        printf(" %16s", QuoridorPathEngine_getName((QuoridorPathEngine)e));
+    printf("\n");
+
+    const int gridSizes[] = { 5, 7, 9 };
+    for (int g = 0; g < 3; g++)
+    {
+        const int gridSize = gridSizes[g];
+        for (int b = 0; b < boardCount; b++)
+            PathBench_randomBoard(&boards[b], gridSize);
+
+        // Référence : longueurs des chemins calculées par le parcours en largeur.
+        int *lengths = (int *)calloc(2 * boardCount, sizeof(int));
+        AssertNew(lengths);
+        long long lengthSum = 0;
+        for (int b = 0; b < boardCount; b++)
+        {
+            QuoridorPos path[MAX_PATH_LEN];
+            for (int playerID = 0; playerID < 2; playerID++)
+            {
+                QuoridorCore_getShortestPathWith(&boards[b], QUORIDOR_PATH_BFS, playerID, path, &lengths[2 * b + playerID]);
+                lengthSum += lengths[2 * b + playerID];
+            }
+        }
+
+        printf("%d x %d ", gridSize, gridSize);
+        for (int e = 0; e < QUORIDOR_PATH_ENGINE_COUNT; e++)
+        {
+            const QuoridorPathEngine engine = (QuoridorPathEngine)e;
+            long long checksum = 0;
+
+            Uint64 start = SDL_GetPerformanceCounter();
+            for (int r = 0; r < repeatCount; r++)
+            {
+                for (int b = 0; b < boardCount; b++)
+                {
+                    QuoridorPos path[MAX_PATH_LEN];
+                    int size;
+                    for (int playerID = 0; playerID < 2; playerID++)
+                    {
+                        QuoridorCore_getShortestPathWith(&boards[b], engine, playerID, path, &size);
+                        checksum += size;
+
+                        if (r == 0 && size != lengths[2 * b + playerID])
+                        {
+                            printf("\n%s: wrong path length on board %d (%d instead of %d)\n",
+                                QuoridorPathEngine_getName(engine), b, size, lengths[2 * b + playerID]);
+                            return EXIT_FAILURE;
+                        }
+                    }
+                }
+            }
+            Uint64 end = SDL_GetPerformanceCounter();
+
+            // La somme des longueurs est vérifiée pour que les appels ne puissent pas être supprimés par le compilateur.
+            if (checksum != lengthSum * repeatCount)
+            {
+                printf("\n%s: wrong checksum\n", QuoridorPathEngine_getName(engine));
+                return EXIT_FAILURE;
+            }
+
+            const double ns = (double)(end - start) / frequency * 1e9 / (2.0 * boardCount * repeatCount);
+            printf(" %16.1f", ns);
+        }
+        printf("\n");
+
+        free(lengths);
+    }
+
+    printf("The distance field engine excludes the incremental update done when a wall is placed.\n");
+
+    free(boards);
+    return EXIT_SUCCESS;
+}
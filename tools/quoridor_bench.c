@@ -0,0 +1,433 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+// Banc d'essai et vérification de la génération des coups (sans fenêtre).
+// 1. Perft : nombre de feuilles de l'arbre de jeu à chaque profondeur, depuis la position standard
+//    et depuis des positions de QuoridorCore_randomStart(), comparé à des valeurs de référence.
+//    Les tours sont joués avec QuoridorCore_makeTurn() / QuoridorCore_unmakeTurn(),
+//    et la clé de Zobrist doit être restaurée après chaque annulation.
+// 2. Débit (appels par seconde) de QuoridorCore_updateValidMoves(), QuoridorCore_canPlayWall()
+//    et QuoridorCore_getShortestPath() sur des plateaux aléatoires.
+//
+// Utilisation : quoridor_bench [profondeur perft] [nombre de plateaux]
+//               quoridor_bench --reference <taille de grille> <graine> <profondeur>
+// La seconde forme affiche une nouvelle entrée de la table de référence,
+// obtenue avec QuoridorCore_randomStart() après srand(graine).
+// Les arguments sont des entiers strictement positifs (la graine peut valoir 0) ;
+// tout autre argument affiche l'utilisation.
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_path.h"
+#include <limits.h>
+
+#define DEFAULT_PERFT_DEPTH 3
+#define DEFAULT_BOARD_COUNT 1000
+#define MAX_PERFT_DEPTH 8
+
+/// @brief Durée minimale (en secondes) de chaque mesure de débit.
+#define BENCH_MIN_SECONDS 0.5
+
+/// @brief Position de départ d'un test perft et ses valeurs de référence.
+typedef struct BenchPosition
+{
+    const char *name;
+    int gridSize;
+    int wallCount;
+
+    /// @brief Murs posés par QuoridorCore_randomStart() : { type, i, j }.
+    /// La liste est enregistrée plutôt que la graine car rand() dépend de la plateforme.
+    int randomWallCount;
+    int randomWalls[4][3];
+
+    /// @brief Nombre de feuilles aux profondeurs 1, 2, ... (0 marque la fin de la liste).
+    uint64_t perft[MAX_PERFT_DEPTH];
+} BenchPosition;
+
+// Références vérifiées avec l'ancienne implémentation du plateau (copie du plateau à chaque tour,
+// QuoridorCore_canMoveTo() et QuoridorCore_canPlayWall() sur chaque case et chaque emplacement).
+static const BenchPosition g_positions[] = {
+    { "standard 9x9", 9, 10, 0, { { 0 } },
+        { 131ULL, 16677ULL, 2062264ULL } },
+    { "standard 7x7", 7, 8, 0, { { 0 } },
+        { 75ULL, 5357ULL, 363872ULL } },
+    { "standard 5x5", 5, 5, 0, { { 0 } },
+        { 35ULL, 1109ULL, 31540ULL, 794442ULL } },
+    { "random 9x9 #1", 9, 10, 4, { { WALL_TYPE_HORIZONTAL, 2, 4 }, { WALL_TYPE_HORIZONTAL, 3, 1 }, { WALL_TYPE_HORIZONTAL, 5, 2 }, { WALL_TYPE_HORIZONTAL, 7, 6 } },
+        { 115ULL, 12823ULL, 1385778ULL } },
+    { "random 9x9 #3", 9, 10, 4, { { WALL_TYPE_HORIZONTAL, 0, 0 }, { WALL_TYPE_VERTICAL, 0, 1 }, { WALL_TYPE_VERTICAL, 0, 2 }, { WALL_TYPE_VERTICAL, 2, 1 } },
+        { 120ULL, 13960ULL, 1573670ULL } },
+    { "random 7x7 #1", 7, 8, 4, { { WALL_TYPE_HORIZONTAL, 1, 2 }, { WALL_TYPE_HORIZONTAL, 1, 4 }, { WALL_TYPE_HORIZONTAL, 2, 1 }, { WALL_TYPE_HORIZONTAL, 4, 0 } },
+        { 61ULL, 3523ULL, 192113ULL } },
+    { "random 5x5 #1", 5, 5, 4, { { WALL_TYPE_HORIZONTAL, 1, 2 }, { WALL_TYPE_HORIZONTAL, 2, 0 }, { WALL_TYPE_HORIZONTAL, 2, 3 }, { WALL_TYPE_HORIZONTAL, 3, 2 } },
+        { 20ULL, 323ULL, 4243ULL, 46051ULL } },
+};
+
+#define BENCH_POSITION_COUNT ((int)(sizeof(g_positions) / sizeof(g_positions[0])))
+
+/// @brief Place une position de test sur le plateau.
+static void Bench_setPosition(QuoridorCore *core, const BenchPosition *position)
+{
+    // QuoridorCore_randomStart() donne deux murs de plus à chaque joueur puis pose quatre murs.
+    const int extraWallCount = position->randomWallCount / 2;
+    QuoridorCore_reset(core, position->gridSize, position->wallCount + extraWallCount, 0);
+
+    for (int w = 0; w < position->randomWallCount; w++)
+    {
+        const WallType type = (WallType)position->randomWalls[w][0];
+        const int i = position->randomWalls[w][1];
+        const int j = position->randomWalls[w][2];
+        assert(QuoridorCore_canPlayWall(core, type, i, j));
+        QuoridorCore_playWall(core, type, i, j);
+    }
+}
+
+/// @brief Renvoie la liste des tours possibles du joueur courant.
+/// @return Le nombre de tours.
+static int Bench_generateTurns(QuoridorCore *core, QuoridorTurn *turns)
+{
+    int count = 0;
+    const QuoridorPos pos = core->positions[core->playerID];
+    for (int m = 0; m < QUORIDOR_MOVE_COUNT; m++)
+    {
+        if ((core->validMoves >> m) & 1)
+        {
+            const QuoridorPos offset = QuoridorCore_getMoveOffset(m);
+            turns[count].action = QUORIDOR_MOVE_TO;
+            turns[count].i = pos.i + offset.i;
+            turns[count].j = pos.j + offset.j;
+            count++;
+        }
+    }
+
+    QuoridorMask hMask, vMask;
+    QuoridorCore_generateLegalWalls(core, &hMask, &vMask);
+    while (!QuoridorMask_isZero(hMask))
+    {
+        const int k = QuoridorMask_popLSB(&hMask);
+        turns[count].action = QUORIDOR_PLAY_HORIZONTAL_WALL;
+        turns[count].i = k / MAX_GRID_SIZE;
+        turns[count].j = k % MAX_GRID_SIZE;
+        count++;
+    }
+    while (!QuoridorMask_isZero(vMask))
+    {
+        const int k = QuoridorMask_popLSB(&vMask);
+        turns[count].action = QUORIDOR_PLAY_VERTICAL_WALL;
+        turns[count].i = k / MAX_GRID_SIZE;
+        turns[count].j = k % MAX_GRID_SIZE;
+        count++;
+    }
+    return count;
+}
+
+/// @brief Compte les feuilles de l'arbre de jeu à une profondeur donnée.
+/// Une partie terminée n'a pas de fils.
+/// @param error Mis à true si une annulation ne restaure pas la clé de Zobrist.
+static uint64_t Bench_perft(QuoridorCore *core, int depth, bool *error)
+{
+    if (depth == 0)
+        return 1;
+    if (core->state != QUORIDOR_STATE_IN_PROGRESS)
+        return 0;
+
+    QuoridorTurn turns[QUORIDOR_MOVE_COUNT + 2 * MAX_GRID_SIZE * MAX_GRID_SIZE];
+    const int turnCount = Bench_generateTurns(core, turns);
+    if (depth == 1)
+        return (uint64_t)turnCount;
+
+    const uint64_t hashKey = core->hashKey;
+    uint64_t count = 0;
+    for (int t = 0; t < turnCount; t++)
+    {
+        QuoridorUndo undo;
+        QuoridorCore_makeTurn(core, turns[t], &undo);
+        count += Bench_perft(core, depth - 1, error);
+        QuoridorCore_unmakeTurn(core, turns[t], &undo);
+
+        if (core->hashKey != hashKey)
+            *error = true;
+    }
+    return count;
+}
+
+/// @brief Affiche une entrée de la table de référence pour une position de QuoridorCore_randomStart().
+static int Bench_printReference(int gridSize, unsigned int seed, int depth)
+{
+    const int wallCount = (gridSize == 9) ? 10 : ((gridSize == 7) ? 8 : 5);
+
+    QuoridorCore core = { 0 };
+    QuoridorCore_reset(&core, gridSize, wallCount, 0);
+    srand(seed);
+    QuoridorCore_randomStart(&core);
+
+    printf("    { \"random %dx%d #%u\", %d, %d, 4, {", gridSize, gridSize, seed, gridSize, wallCount);
+    const QuoridorMask masks[2] = { core.hWalls, core.vWalls };
+    const char *types[2] = { "WALL_TYPE_HORIZONTAL", "WALL_TYPE_VERTICAL" };
+    const char *separator = " ";
+    for (int t = 0; t < 2; t++)
+    {
+        QuoridorMask mask = masks[t];
+        while (!QuoridorMask_isZero(mask))
+        {
+            const int k = QuoridorMask_popLSB(&mask);
+            printf("%s{ %s, %d, %d }", separator, types[t], k / MAX_GRID_SIZE, k % MAX_GRID_SIZE);
+            separator = ", ";
+        }
+    }
+    printf(" },\n        {");
+
+    separator = " ";
+    for (int d = 1; d <= depth; d++)
+    {
+        bool error = false;
+        printf("%s%lluULL", separator, (unsigned long long)Bench_perft(&core, d, &error));
+        separator = ", ";
+        if (error)
+        {
+            printf("\nThe Zobrist key is not restored by QuoridorCore_unmakeTurn()\n");
+            return EXIT_FAILURE;
+        }
+    }
+    printf(" } },\n");
+    return EXIT_SUCCESS;
+}
+
+/// @brief Lance les tests perft.
+/// @return true si tous les résultats sont corrects.
+static bool Bench_runPerft(int maxDepth, double frequency)
+{
+    bool success = true;
+    printf("perft (leaf nodes)\n");
+    printf("%-22s %5s %14s %14s %10s %6s\n", "position", "depth", "nodes", "reference", "Mnodes/s", "");
+
+    for (int p = 0; p < BENCH_POSITION_COUNT; p++)
+    {
+        const BenchPosition *position = &g_positions[p];
+        QuoridorCore core = { 0 };
+        Bench_setPosition(&core, position);
+
+        for (int depth = 1; depth <= maxDepth; depth++)
+        {
+            const uint64_t reference = (depth <= MAX_PERFT_DEPTH) ? position->perft[depth - 1] : 0;
+            bool error = false;
+
+            const Uint64 start = SDL_GetPerformanceCounter();
+            const uint64_t count = Bench_perft(&core, depth, &error);
+            const Uint64 end = SDL_GetPerformanceCounter();
+            const double seconds = (double)(end - start) / frequency;
+
+            const char *status = "";
+            if (error)
+                status = "UNDO";
+            else if (reference == 0)
+                status = "-";
+            else
+                status = (count == reference) ? "ok" : "FAIL";
+            success &= !error && (reference == 0 || count == reference);
+
+            char referenceText[32] = "-";
+            if (reference)
+                snprintf(referenceText, sizeof(referenceText), "%llu", (unsigned long long)reference);
+
+            printf("%-22s %5d %14llu %14s %10.2f %6s\n",
+                position->name, depth, (unsigned long long)count, referenceText,
+                seconds > 0.0 ? (double)count / seconds * 1e-6 : 0.0, status);
+        }
+    }
+    return success;
+}
+
+/// @brief Joue un tour aléatoire (un mur avec une probabilité de 1/2 s'il en reste, sinon un déplacement).
+static void Bench_playRandomTurn(QuoridorCore *core)
+{
+    QuoridorTurn turns[QUORIDOR_MOVE_COUNT + 2 * MAX_GRID_SIZE * MAX_GRID_SIZE];
+    const int turnCount = Bench_generateTurns(core, turns);
+    assert(turnCount > 0);
+
+    int moveCount = 0;
+    while (moveCount < turnCount && turns[moveCount].action == QUORIDOR_MOVE_TO)
+        moveCount++;
+
+    QuoridorTurn turn;
+    if (turnCount > moveCount && rand() % 2)
+        turn = turns[moveCount + rand() % (turnCount - moveCount)];
+    else
+        turn = turns[rand() % moveCount];
+
+    QuoridorCore_playTurn(core, turn);
+}
+
+/// @brief Génère un plateau aléatoire dont la partie est toujours en cours.
+static void Bench_randomBoard(QuoridorCore *core, int gridSize)
+{
+    const int wallCount = (gridSize == 9) ? 10 : gridSize + 1;
+    const int turnCount = rand() % (4 * wallCount + 1);
+
+    do
+    {
+        QuoridorCore_reset(core, gridSize, wallCount, rand() % 2);
+        if (rand() % 2)
+            QuoridorCore_randomStart(core);
+        for (int t = 0; t < turnCount && core->state == QUORIDOR_STATE_IN_PROGRESS; t++)
+            Bench_playRandomTurn(core);
+    } while (core->state != QUORIDOR_STATE_IN_PROGRESS);
+}
+
+/// @brief Mesure le débit des fonctions de génération des coups.
+/// @return true si les résultats de QuoridorCore_canPlayWall() sont cohérents avec ceux de QuoridorCore_generateLegalWalls().
+static bool Bench_runThroughput(int boardCount, double frequency)
+{
+    QuoridorCore *boards = (QuoridorCore *)calloc(boardCount, sizeof(QuoridorCore));
+    AssertNew(boards);
+
+    bool success = true;
+    printf("\nthroughput on %d random boards (Mcalls/s)\n", boardCount);
+    printf("%-6s %18s %18s %18s\n", "grid", "updateValidMoves", "canPlayWall", "getShortestPath");
+
+    const int gridSizes[] = { 5, 7, 9 };
+    for (int g = 0; g < 3; g++)
+    {
+        const int gridSize = gridSizes[g];
+        for (int b = 0; b < boardCount; b++)
+            Bench_randomBoard(&boards[b], gridSize);
+
+        // Référence : nombre de murs légaux donné par la génération en masse.
+        long long legalWallCount = 0;
+        for (int b = 0; b < boardCount; b++)
+        {
+            QuoridorMask hMask, vMask;
+            QuoridorCore_generateLegalWalls(&boards[b], &hMask, &vMask);
+            legalWallCount += QuoridorMask_popCount(hMask) + QuoridorMask_popCount(vMask);
+        }
+
+        double rates[3] = { 0 };
+        for (int f = 0; f < 3; f++)
+        {
+            long long callCount = 0;
+            long long checksum = 0;
+            int repeatCount = 0;
+            const Uint64 start = SDL_GetPerformanceCounter();
+            Uint64 end = start;
+
+            // La somme des résultats est conservée pour que les appels ne puissent pas être supprimés par le compilateur.
+            do
+            {
+                for (int b = 0; b < boardCount; b++)
+                {
+                    QuoridorCore *core = &boards[b];
+                    switch (f)
+                    {
+                    case 0:
+                        QuoridorCore_updateValidMoves(core);
+                        checksum += core->validMoves;
+                        callCount++;
+                        break;
+                    case 1:
+                        for (int i = 0; i < gridSize - 1; i++)
+                        {
+                            for (int j = 0; j < gridSize - 1; j++)
+                            {
+                                checksum += QuoridorCore_canPlayWall(core, WALL_TYPE_HORIZONTAL, i, j);
+                                checksum += QuoridorCore_canPlayWall(core, WALL_TYPE_VERTICAL, i, j);
+                            }
+                        }
+                        callCount += 2 * (gridSize - 1) * (gridSize - 1);
+                        break;
+                    default:
+                        for (int playerID = 0; playerID < 2; playerID++)
+                        {
+                            QuoridorPos path[MAX_PATH_LEN];
+                            int size;
+                            QuoridorCore_getShortestPath(core, playerID, path, &size);
+                            checksum += size;
+                        }
+                        callCount += 2;
+                        break;
+                    }
+                }
+                repeatCount++;
+                end = SDL_GetPerformanceCounter();
+            } while ((double)(end - start) / frequency < BENCH_MIN_SECONDS);
+
+            if (f == 1 && checksum != legalWallCount * repeatCount)
+            {
+                printf("%d x %d: QuoridorCore_canPlayWall() disagrees with QuoridorCore_generateLegalWalls()\n",
+                    gridSize, gridSize);
+                success = false;
+            }
+            rates[f] = (double)callCount / ((double)(end - start) / frequency) * 1e-6;
+        }
+
+        printf("%d x %d  %18.2f %18.2f %18.2f\n", gridSize, gridSize, rates[0], rates[1], rates[2]);
+    }
+
+    free(boards);
+    return success;
+}
+
+/// @brief Lit un argument entier de la ligne de commande.
+/// @param text Argument.
+/// @param minValue Valeur minimale acceptée.
+/// @param value Adresse dans laquelle est écrite la valeur lue.
+/// @return false si l'argument n'est pas un entier supérieur ou égal à minValue.
+static bool Bench_parseInt(const char *text, int minValue, int *value)
+{
+    char *end = NULL;
+    const long number = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || number < minValue || number > INT_MAX)
+        return false;
+
+    *value = (int)number;
+    return true;
+}
+
+static void Bench_printUsage(const char *program)
+{
+    printf("Usage: %s [perft depth] [board count]\n", program);
+    printf("       %s --reference <grid size> <seed> <depth>\n", program);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && strcmp(argv[1], "--reference") == 0)
+    {
+        int gridSize = 9;
+        int seed = 1;
+        int depth = DEFAULT_PERFT_DEPTH;
+        bool valid = argc <= 5;
+        valid = valid && (argc <= 2 || Bench_parseInt(argv[2], 5, &gridSize));
+        valid = valid && (argc <= 3 || Bench_parseInt(argv[3], 0, &seed));
+        valid = valid && (argc <= 4 || Bench_parseInt(argv[4], 1, &depth));
+        if (!valid || (gridSize != 5 && gridSize != 7 && gridSize != 9) || depth > MAX_PERFT_DEPTH)
+        {
+            Bench_printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        return Bench_printReference(gridSize, (unsigned int)seed, depth);
+    }
+
+    // Les arguments non numériques (--help par exemple) sont refusés plutôt que lus comme 0.
+    int perftDepth = DEFAULT_PERFT_DEPTH;
+    int boardCount = DEFAULT_BOARD_COUNT;
+    bool valid = argc <= 3;
+    valid = valid && (argc <= 1 || Bench_parseInt(argv[1], 1, &perftDepth));
+    valid = valid && (argc <= 2 || Bench_parseInt(argv[2], 1, &boardCount));
+    if (!valid || perftDepth > MAX_PERFT_DEPTH)
+    {
+        Bench_printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const double frequency = (double)SDL_GetPerformanceFrequency();
+    srand(1);
+
+    bool success = Bench_runPerft(perftDepth, frequency);
+    success &= Bench_runThroughput(boardCount, frequency);
+
+    printf("\n%s\n", success ? "All checks passed." : "Some checks FAILED.");
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,254 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+// Création d'un livre d'ouvertures (voir core/quoridor_book.h) à partir de deux sources :
+// - des lignes d'ouverture calculées par recherche profonde depuis la position initiale
+//   (le bruit de l'évaluation fait varier les lignes d'une recherche à l'autre) ;
+// - des parties enregistrées, par exemple celles de quoridor_selfplay --output.
+// Seuls les premiers tours de chaque ligne ou partie sont retenus. Le poids d'un tour
+// est le nombre de fois où il a été joué dans la position ; dans une partie enregistrée,
+// seuls les tours du vainqueur comptent (ceux des deux joueurs pour une partie nulle).
+//
+// Utilisation : quoridor_book [options] <livre>
+//   --lines <n>          nombre de lignes calculées par recherche profonde (défaut : 0)
+//   --depth <n>          profondeur de ces recherches (défaut : 6)
+//   --threads <n>        nombre de threads de chaque recherche (défaut : nombre de coeurs)
+//   --grid <n>           taille de la grille des lignes calculées, 5, 7 ou 9 (défaut : 9)
+//   --walls <n>          nombre de murs par joueur des lignes calculées (défaut : 10)
+//   --input <fichier>    ajoute les parties d'un fichier de parties (option répétable)
+//   --plies <n>          nombre de tours retenus au début de chaque ligne ou partie (défaut : 8)
+//   --min-weight <n>     poids minimal d'un tour pour figurer dans le livre (défaut : 1)
+//   --seed <n>           graine du bruit des recherches (défaut : 1)
+//
+// Le jeu charge le livre data/opening.qob au démarrage (voir FILE_OPENING_BOOK).
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_ai.h"
+#include "core/quoridor_book.h"
+#include "core/quoridor_record.h"
+#include "core/utils.h"
+
+typedef struct BookBuilder
+{
+    /// @brief Tours collectés (non triés, avec doublons).
+    QuoridorBookEntry *entries;
+    int entryCount;
+    int entryCapacity;
+
+    /// @brief Nombre de tours retenus au début de chaque ligne ou partie.
+    int plyCount;
+} BookBuilder;
+
+static void BookBuilder_add(BookBuilder *self, const QuoridorCore *core, QuoridorTurn turn)
+{
+    if (self->entryCount >= self->entryCapacity)
+    {
+        self->entryCapacity = Int_max(1024, self->entryCapacity * 2);
+        self->entries = (QuoridorBookEntry *)realloc(self->entries, self->entryCapacity * sizeof(QuoridorBookEntry));
+        AssertNew(self->entries);
+    }
+
+    QuoridorBookEntry *entry = &self->entries[self->entryCount++];
+    memset(entry, 0, sizeof(QuoridorBookEntry));
+    entry->key = core->hashKey;
+    entry->turn = QuoridorBook_encodeTurn(turn);
+    entry->weight = 1;
+}
+
+/// @brief Calcule des lignes d'ouverture par recherche profonde depuis la position initiale.
+static void BookBuilder_addSearchedLines(
+    BookBuilder *self, int lineCount, int gridSize, int wallCount, const AISearchParams *params)
+{
+    void *aiData = AIData_create(NULL);
+
+    for (int line = 0; line < lineCount; line++)
+    {
+        QuoridorCore core = { 0 };
+        QuoridorCore_reset(&core, gridSize, wallCount, 0);
+        AIData_reset(aiData);
+
+        printf("Line %d:", line + 1);
+        for (int ply = 0; ply < self->plyCount && core.state == QUORIDOR_STATE_IN_PROGRESS; ply++)
+        {
+            const QuoridorTurn turn = QuoridorCore_computeTurnWithParams(&core, params, aiData);
+            if (!QuoridorCore_canPlayTurn(&core, turn))
+                break;
+
+            char text[QUORIDOR_TURN_STRING_SIZE];
+            QuoridorTurn_toString(turn, text);
+            printf(" %s", text);
+            fflush(stdout);
+
+            BookBuilder_add(self, &core, turn);
+            QuoridorCore_playTurn(&core, turn);
+        }
+        printf("\n");
+    }
+
+    AIData_destroy(aiData);
+}
+
+/// @brief Ajoute les premiers tours des parties d'un fichier.
+/// @return Le nombre de parties lues, ou -1 si le fichier ne peut pas être lu.
+static int BookBuilder_addRecords(BookBuilder *self, const char *path)
+{
+    QuoridorRecordReader *reader = QuoridorRecordReader_create(path);
+    if (reader == NULL) return -1;
+
+    QuoridorRecord record = { 0 };
+    QuoridorRecordIndex index = { 0 };
+    int gameCount = 0;
+    while (QuoridorRecordReader_next(reader, &record))
+    {
+        // Les tours d'une partie sans vainqueur comptent pour les deux joueurs.
+        int winner = -1;
+        if (record.finalState == QUORIDOR_STATE_P0_WON) winner = 0;
+        else if (record.finalState == QUORIDOR_STATE_P1_WON) winner = 1;
+
+        // L'index tronque la partie au premier tour illégal.
+        if (!QuoridorRecordIndex_build(&index, &record))
+            continue;
+
+        QuoridorCore core;
+        QuoridorRecordIndex_getPosition(&index, 0, &core);
+        const int plyCount = Int_min(self->plyCount, index.turnCount);
+        for (int ply = 0; ply < plyCount; ply++)
+        {
+            if (winner < 0 || core.playerID == winner)
+                BookBuilder_add(self, &core, index.turns[ply]);
+            QuoridorCore_playTurn(&core, index.turns[ply]);
+        }
+        gameCount++;
+    }
+    if (reader->corrupted)
+        printf("%s: invalid game after %d games\n", path, gameCount);
+
+    QuoridorRecordIndex_clear(&index);
+    QuoridorRecord_clear(&record);
+    QuoridorRecordReader_destroy(reader);
+    return gameCount;
+}
+
+/// @brief Retire les tours dont le poids total est inférieur au poids minimal.
+/// Les entrées doivent être fusionnées (voir QuoridorBook_merge()).
+static int BookBuilder_filter(QuoridorBookEntry *entries, int entryCount, uint32_t minWeight)
+{
+    int count = 0;
+    for (int k = 0; k < entryCount; k++)
+    {
+        if (entries[k].weight >= minWeight)
+            entries[count++] = entries[k];
+    }
+    return count;
+}
+
+static void BookBuilder_printUsage(const char *program)
+{
+    printf("Usage: %s [--lines <n>] [--depth <n>] [--threads <n>] [--grid <n>] [--walls <n>]\n"
+        "    [--input <file>]... [--plies <n>] [--min-weight <n>] [--seed <n>] <book>\n",
+        program);
+}
+
+int main(int argc, char *argv[])
+{
+    BookBuilder self = { 0 };
+    self.plyCount = 8;
+
+    AISearchParams params = { 0 };
+    params.depth = 6;
+    params.threadCount = SDL_GetNumLogicalCPUCores();
+    params.parallelMode = AI_PARALLEL_YBWC;
+
+    const char *inputs[64];
+    int inputCount = 0;
+    const char *outputPath = NULL;
+    int lineCount = 0;
+    int gridSize = 9;
+    int wallCount = 10;
+    int minWeight = 1;
+    unsigned int seed = 1;
+    bool valid = true;
+
+    for (int a = 1; a < argc && valid; a++)
+    {
+        const bool hasValue = (a + 1 < argc);
+        if (strcmp(argv[a], "--lines") == 0 && hasValue)
+            lineCount = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--depth") == 0 && hasValue)
+            params.depth = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--threads") == 0 && hasValue)
+            params.threadCount = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--grid") == 0 && hasValue)
+            gridSize = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--walls") == 0 && hasValue)
+            wallCount = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--input") == 0 && hasValue && inputCount < 64)
+            inputs[inputCount++] = argv[++a];
+        else if (strcmp(argv[a], "--plies") == 0 && hasValue)
+            self.plyCount = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--min-weight") == 0 && hasValue)
+            minWeight = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--seed") == 0 && hasValue)
+            seed = (unsigned int)atoi(argv[++a]);
+        else if (argv[a][0] != '-' && outputPath == NULL)
+            outputPath = argv[a];
+        else
+            valid = false;
+    }
+
+    valid = valid && outputPath != NULL && (lineCount > 0 || inputCount > 0)
+        && lineCount >= 0 && params.depth > 0 && self.plyCount > 0 && minWeight > 0
+        && (gridSize == 5 || gridSize == 7 || gridSize == 9) && wallCount >= 0 && wallCount <= 20;
+    if (!valid)
+    {
+        BookBuilder_printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    params.seed = seed;
+    for (int k = 0; k < inputCount; k++)
+    {
+        const int gameCount = BookBuilder_addRecords(&self, inputs[k]);
+        if (gameCount < 0)
+        {
+            printf("Cannot read %s\n", inputs[k]);
+            return EXIT_FAILURE;
+        }
+        printf("%s: %d games\n", inputs[k], gameCount);
+    }
+
+    if (lineCount > 0)
+    {
+        printf("%d lines of %d turns on %dx%d, %d walls, depth %d\n",
+            lineCount, self.plyCount, gridSize, gridSize, wallCount, params.depth);
+        BookBuilder_addSearchedLines(&self, lineCount, gridSize, wallCount, &params);
+    }
+
+    // Les poids d'un même tour sont additionnés avant d'être comparés au poids minimal.
+    int entryCount = QuoridorBook_merge(self.entries, self.entryCount);
+    entryCount = BookBuilder_filter(self.entries, entryCount, (uint32_t)minWeight);
+    entryCount = QuoridorBook_write(outputPath, self.entries, entryCount);
+    free(self.entries);
+
+    if (entryCount < 0)
+    {
+        printf("Cannot write %s\n", outputPath);
+        return EXIT_FAILURE;
+    }
+
+    int positionCount = 0;
+    QuoridorBook *book = QuoridorBook_create(outputPath);
+    for (int k = 0; book && k < book->m_entryCount; k++)
+    {
+        if (k == 0 || book->m_entries[k].key != book->m_entries[k - 1].key)
+            positionCount++;
+    }
+    QuoridorBook_destroy(book);
+
+    printf("%s: %d turns in %d positions\n", outputPath, entryCount, positionCount);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,408 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+// Moteur de Quoridor sans fenêtre, piloté par un protocole textuel sur l'entrée et la sortie standard
+// (sur le modèle du protocole UCI des échecs). Chaque commande tient sur une ligne.
+// Les tours sont écrits en notation algébrique (voir QuoridorTurn_toString()) : "e2", "c3h", "d4v".
+//
+// Commandes reçues :
+//   uqi                                  -> id name ..., id author ..., option ..., uqiok
+//   isready                              -> readyok (immédiatement, même pendant une recherche)
+//   setoption name <nom> value <valeur>  Threads (1..64), Mode (rootsplit|lazysmp|ybwc), Engine (minmax|mcts)
+//   newgame                              vide les données de l'IA (table de transposition, arbre MCTS)
+//   position startpos [grid <n>] [walls <n>] [first <0|1>] [setup <mur>...] [moves <tour>...]
+//                                        setup : murs de départ (par exemple ceux de QuoridorCore_randomStart())
+//   go [depth <n>] [movetime <ms>] [playouts <n>] [infinite]
+//   stop                                 interrompt la recherche, qui renvoie son meilleur coup
+//   d                                    affiche le plateau
+//   quit
+//
+// Réponses du moteur :
+//   info depth <n> score cp <n> nodes <n> time <ms> nps <n> pv <tour>...
+//   info depth <n> score mate <n> ...    fin de partie en n tours (négatif si elle est perdue)
+//   bestmove <tour>                      "none" si la partie est terminée
+//   info string <texte>                  erreurs et messages
+//
+// Utilisation : quoridor_engine
+//
+// Le moteur n'utilise de la SDL que les threads et les horloges (voir core/core_settings.h) :
+// il n'initialise aucun sous-système et ne dépend ni de la vidéo, ni de SDL_image, ni de SDL_ttf.
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_ai.h"
+#include "core/utils.h"
+#include <stdarg.h>
+
+#define ENGINE_NAME "Quoridor"
+#define ENGINE_AUTHORS "Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE"
+#define ENGINE_MAX_LINE 16384
+#define ENGINE_MAX_THREADS 64
+
+typedef struct Engine
+{
+    /// @brief Position courante, définie par la commande position.
+    QuoridorCore core;
+
+    /// @brief Données de l'IA, conservées d'une recherche à l'autre.
+    void *aiData;
+
+    /// @brief Options de la recherche (setoption).
+    int threadCount;
+    AIParallelMode parallelMode;
+    AIEngine engine;
+
+    /// @brief Thread de la recherche en cours (NULL si aucune).
+    SDL_Thread *thread;
+
+    /// @brief Drapeau d'arrêt de la recherche en cours.
+    SDL_AtomicInt stopFlag;
+
+    /// @brief Copie de la position et paramètres de la recherche en cours.
+    QuoridorCore searchCore;
+    AISearchParams params;
+
+    /// @brief Mutex protégeant la sortie standard, écrite par les deux threads.
+    SDL_Mutex *outputMutex;
+} Engine;
+
+/// @brief Écrit une ligne sur la sortie standard.
+static void Engine_send(Engine *self, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    SDL_LockMutex(self->outputMutex);
+    vprintf(format, args);
+    printf("\n");
+    fflush(stdout);
+    SDL_UnlockMutex(self->outputMutex);
+    va_end(args);
+}
+
+/// @brief Écrit une ligne info à la fin de chaque itération de la recherche.
+static void Engine_onIteration(void *userData, const AIIterationInfo *info)
+{
+    Engine *self = (Engine *)userData;
+
+    char score[32];
+    if (fabsf(info->score) > AI_MATE_SCORE)
+    {
+        // Un score de victoire en n tours vaut 10000 - 2n.
+        const int turnCount = (int)roundf((10000.0f - fabsf(info->score)) / 2.0f);
+        snprintf(score, sizeof(score), "mate %d", (info->score > 0.0f) ? turnCount : -turnCount);
+    }
+    else
+    {
+        snprintf(score, sizeof(score), "cp %d", (int)roundf(info->score * 100.0f));
+    }
+
+    char pv[AI_MAX_PV_LENGTH * QUORIDOR_TURN_STRING_SIZE] = { 0 };
+    for (int k = 0; k < info->pvLength; k++)
+    {
+        char turn[QUORIDOR_TURN_STRING_SIZE];
+        QuoridorTurn_toString(info->pv[k], turn);
+        if (k > 0) strcat(pv, " ");
+        strcat(pv, turn);
+    }
+
+    const long long nps = (info->elapsedMS > 0.0) ? (long long)(info->nodeCount * 1000.0 / info->elapsedMS) : 0;
+    Engine_send(self, "info depth %d score %s nodes %d time %lld nps %lld pv %s",
+        info->depth, score, info->nodeCount, (long long)info->elapsedMS, nps, pv);
+}
+
+static int Engine_run(void *data)
+{
+    Engine *self = (Engine *)data;
+    QuoridorTurn turn = QuoridorCore_computeTurnWithParams(&self->searchCore, &self->params, self->aiData);
+
+    // Une recherche arrêtée avant la fin de sa première itération n'a pas de coup :
+    // on joue alors le meilleur coup d'une recherche à profondeur 1, qui n'est pas interruptible.
+    if (turn.action == QUORIDOR_ACTION_UNDEFINED && self->searchCore.state == QUORIDOR_STATE_IN_PROGRESS)
+    {
+        AISearchParams params = { 0 };
+        params.depth = 1;
+        turn = QuoridorCore_computeTurnWithParams(&self->searchCore, &params, self->aiData);
+    }
+
+    char text[QUORIDOR_TURN_STRING_SIZE];
+    QuoridorTurn_toString(turn, text);
+    Engine_send(self, "bestmove %s", text);
+    return 0;
+}
+
+/// @brief Attend la fin de la recherche en cours, en l'interrompant si stop vaut true.
+static void Engine_wait(Engine *self, bool stop)
+{
+    if (self->thread == NULL)
+        return;
+
+    if (stop)
+        SDL_SetAtomicInt(&self->stopFlag, 1);
+    SDL_WaitThread(self->thread, NULL);
+    self->thread = NULL;
+}
+
+/// @brief Lit l'entier suivant de la ligne de commande.
+static bool Engine_nextInt(int *value)
+{
+    const char *token = strtok(NULL, " \t");
+    if (token == NULL)
+        return false;
+
+    char *end = NULL;
+    const long number = strtol(token, &end, 10);
+    if (*end != '\0')
+        return false;
+
+    *value = (int)number;
+    return true;
+}
+
+static void Engine_setOption(Engine *self)
+{
+    // setoption name <nom> value <valeur>
+    const char *keyword = strtok(NULL, " \t");
+    const char *name = strtok(NULL, " \t");
+    const char *keyword2 = strtok(NULL, " \t");
+    const char *value = strtok(NULL, " \t");
+    if (!keyword || strcmp(keyword, "name") || !name || !keyword2 || strcmp(keyword2, "value") || !value)
+    {
+        Engine_send(self, "info string usage: setoption name <name> value <value>");
+        return;
+    }
+
+    if (strcmp(name, "Threads") == 0)
+    {
+        self->threadCount = Int_clamp(atoi(value), 1, ENGINE_MAX_THREADS);
+    }
+    else if (strcmp(name, "Mode") == 0 && strcmp(value, "rootsplit") == 0)
+    {
+        self->parallelMode = AI_PARALLEL_ROOT_SPLIT;
+    }
+    else if (strcmp(name, "Mode") == 0 && strcmp(value, "lazysmp") == 0)
+    {
+        self->parallelMode = AI_PARALLEL_LAZY_SMP;
+    }
+    else if (strcmp(name, "Mode") == 0 && strcmp(value, "ybwc") == 0)
+    {
+        self->parallelMode = AI_PARALLEL_YBWC;
+    }
+    else if (strcmp(name, "Engine") == 0 && strcmp(value, "minmax") == 0)
+    {
+        self->engine = AI_ENGINE_MINMAX;
+    }
+    else if (strcmp(name, "Engine") == 0 && strcmp(value, "mcts") == 0)
+    {
+        self->engine = AI_ENGINE_MCTS;
+    }
+    else
+    {
+        Engine_send(self, "info string unknown option %s = %s", name, value);
+    }
+}
+
+static void Engine_position(Engine *self)
+{
+    int gridSize = 9;
+    int wallCount = 10;
+    int firstPlayer = 0;
+
+    const char *token = strtok(NULL, " \t");
+    if (token == NULL || strcmp(token, "startpos"))
+    {
+        Engine_send(self, "info string usage: position startpos [grid <n>] [walls <n>] [first <0|1>] [setup ...] [moves ...]");
+        return;
+    }
+
+    QuoridorCore core = { 0 };
+    QuoridorTurn setup[2 * MAX_GRID_SIZE * MAX_GRID_SIZE];
+    int setupCount = 0;
+    bool boardReady = false;
+    bool readingSetup = false;
+
+    for (token = strtok(NULL, " \t"); token != NULL; token = strtok(NULL, " \t"))
+    {
+        bool valid = true;
+        if (strcmp(token, "grid") == 0)
+            valid = Engine_nextInt(&gridSize) && (gridSize == 5 || gridSize == 7 || gridSize == 9);
+        else if (strcmp(token, "walls") == 0)
+            valid = Engine_nextInt(&wallCount) && wallCount >= 0 && wallCount <= 20;
+        else if (strcmp(token, "first") == 0)
+            valid = Engine_nextInt(&firstPlayer) && (firstPlayer == 0 || firstPlayer == 1);
+        else if (strcmp(token, "setup") == 0)
+            readingSetup = true;
+        else if (strcmp(token, "moves") == 0)
+        {
+            readingSetup = false;
+            if (!boardReady)
+            {
+                QuoridorCore_reset(&core, gridSize, wallCount, firstPlayer);
+                valid = QuoridorCore_playStartWalls(&core, setup, setupCount);
+                boardReady = true;
+            }
+        }
+        else
+        {
+            QuoridorTurn turn;
+            valid = QuoridorTurn_fromString(&turn, token);
+            if (valid && readingSetup)
+            {
+                valid = turn.action != QUORIDOR_MOVE_TO && setupCount < 2 * MAX_GRID_SIZE * MAX_GRID_SIZE;
+                if (valid) setup[setupCount++] = turn;
+            }
+            else if (valid && boardReady)
+            {
+                valid = QuoridorCore_canPlayTurn(&core, turn);
+                if (valid) QuoridorCore_playTurn(&core, turn);
+            }
+            else
+            {
+                valid = false;
+            }
+        }
+
+        if (!valid)
+        {
+            Engine_send(self, "info string invalid position at '%s'", token);
+            return;
+        }
+    }
+
+    if (!boardReady)
+    {
+        QuoridorCore_reset(&core, gridSize, wallCount, firstPlayer);
+        if (!QuoridorCore_playStartWalls(&core, setup, setupCount))
+        {
+            Engine_send(self, "info string invalid setup walls");
+            return;
+        }
+    }
+
+    self->core = core;
+}
+
+static void Engine_go(Engine *self)
+{
+    AISearchParams params = { 0 };
+    params.engine = self->engine;
+    params.threadCount = self->threadCount;
+    params.parallelMode = self->parallelMode;
+    params.stopFlag = &self->stopFlag;
+    params.onIteration = Engine_onIteration;
+    params.userData = self;
+
+    bool infinite = false;
+    for (const char *token = strtok(NULL, " \t"); token != NULL; token = strtok(NULL, " \t"))
+    {
+        int value = 0;
+        bool valid = true;
+        if (strcmp(token, "infinite") == 0)
+            infinite = true;
+        else if (!Engine_nextInt(&value) || value <= 0)
+            valid = false;
+        else if (strcmp(token, "depth") == 0)
+            params.depth = value;
+        else if (strcmp(token, "movetime") == 0)
+            params.budgetMS = (Uint64)value;
+        else if (strcmp(token, "playouts") == 0)
+            params.playoutCount = value;
+        else
+            valid = false;
+
+        if (!valid)
+        {
+            Engine_send(self, "info string invalid go parameter '%s'", token);
+            return;
+        }
+    }
+
+    // Sans limite de temps, l'approfondissement itératif va jusqu'à la profondeur demandée
+    // (ou jusqu'à la commande stop) en envoyant une ligne info par itération.
+    if (params.budgetMS == 0 && (params.depth > 0 || infinite))
+        params.budgetMS = UINT32_MAX;
+    if (params.budgetMS == 0 && params.playoutCount == 0)
+        params.depth = 4;
+
+    self->searchCore = self->core;
+    self->params = params;
+    SDL_SetAtomicInt(&self->stopFlag, 0);
+    self->thread = SDL_CreateThread(Engine_run, "Engine", self);
+    AssertNew(self->thread);
+}
+
+int main(int argc, char *argv[])
+{
+    srand((unsigned int)time(NULL));
+
+    Engine engine = { 0 };
+    engine.outputMutex = SDL_CreateMutex();
+    AssertNew(engine.outputMutex);
+    engine.threadCount = 1;
+    engine.parallelMode = AI_PARALLEL_LAZY_SMP;
+    engine.engine = AI_ENGINE_MINMAX;
+    QuoridorCore_reset(&engine.core, 9, 10, 0);
+    engine.aiData = AIData_create(&engine.core);
+
+    static char line[ENGINE_MAX_LINE];
+    while (fgets(line, sizeof(line), stdin))
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        const char *command = strtok(line, " \t");
+        if (command == NULL)
+            continue;
+
+        if (strcmp(command, "quit") == 0)
+        {
+            break;
+        }
+        else if (strcmp(command, "uqi") == 0)
+        {
+            Engine_send(&engine, "id name " ENGINE_NAME);
+            Engine_send(&engine, "id author " ENGINE_AUTHORS);
+            Engine_send(&engine, "option name Threads type spin default 1 min 1 max %d", ENGINE_MAX_THREADS);
+            Engine_send(&engine, "option name Mode type combo default lazysmp var rootsplit var lazysmp var ybwc");
+            Engine_send(&engine, "option name Engine type combo default minmax var minmax var mcts");
+            Engine_send(&engine, "uqiok");
+        }
+        else if (strcmp(command, "isready") == 0)
+        {
+            Engine_send(&engine, "readyok");
+        }
+        else if (strcmp(command, "stop") == 0)
+        {
+            Engine_wait(&engine, true);
+        }
+        else if (strcmp(command, "d") == 0)
+        {
+            SDL_LockMutex(engine.outputMutex);
+            QuoridorCore_print(&engine.core);
+            fflush(stdout);
+            SDL_UnlockMutex(engine.outputMutex);
+        }
+        else
+        {
+            // Les autres commandes modifient l'état du moteur : la recherche en cours est d'abord arrêtée.
+            Engine_wait(&engine, true);
+
+            if (strcmp(command, "setoption") == 0)
+                Engine_setOption(&engine);
+            else if (strcmp(command, "newgame") == 0)
+                AIData_reset(engine.aiData);
+            else if (strcmp(command, "position") == 0)
+                Engine_position(&engine);
+            else if (strcmp(command, "go") == 0)
+                Engine_go(&engine);
+            else
+                Engine_send(&engine, "info string unknown command %s", command);
+        }
+    }
+
+    Engine_wait(&engine, true);
+    AIData_destroy(engine.aiData);
+    SDL_DestroyMutex(engine.outputMutex);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,477 @@
+/*
+    Copyright (c) Arnaud BANNIER, Nicolas BODIN and Matthieu LE BERRE.
+    Licensed under the MIT License.
+    See LICENSE.md in the project root for license information.
+*/
+
+// Tournoi entre deux configurations de l'IA, joué sans fenêtre par un groupe de threads.
+// Les parties sont jouées par paires : les deux parties d'une paire partent de la même ouverture
+// (QuoridorCore_randomStart()) et chaque configuration y joue une fois chaque couleur.
+// Le programme affiche le score de la configuration A, l'écart d'Elo estimé et,
+// avec --sprt, le rapport de vraisemblance d'un test séquentiel (SPRT) qui arrête le tournoi
+// dès que l'une des deux hypothèses est acceptée.
+//
+// Utilisation : quoridor_selfplay [options]
+//   -a <config>          configuration A (défaut : depth=2)
+//   -b <config>          configuration B (défaut : depth=2)
+//   --games <n>          nombre de parties (défaut : 1000)
+//   --threads <n>        nombre de parties jouées simultanément (défaut : nombre de coeurs)
+//   --grid <n>           taille de la grille, 5, 7 ou 9 (défaut : 9)
+//   --walls <n>          nombre de murs par joueur (défaut : 10)
+//   --max-plies <n>      nombre de tours au-delà duquel la partie est nulle (défaut : 200)
+//   --seed <n>           graine des ouvertures (défaut : 1)
+//   --no-random-start    toutes les parties partent de la position initiale
+//   --sprt <elo0> <elo1> [alpha] [beta]
+//                        teste H0 : elo = elo0 contre H1 : elo = elo1 (alpha et beta : 0.05 par défaut)
+//   --output <fichier>   enregistre les parties dans un fichier binaire (voir core/quoridor_record.h)
+//
+// Une configuration est une liste de clés séparées par des virgules, par exemple
+// "depth=3,threat=12,center=1" ou "mcts,time=100" :
+//   depth=<n>            profondeur (défaut : 2, profondeur maximale avec time)
+//   time=<ms>            temps de réflexion par coup (approfondissement itératif)
+//   mcts                 recherche Monte-Carlo au lieu de min-max
+//   playouts=<n>         nombre de simulations par coup (MCTS)
+//   path, length, threat, walls, center, early
+//                        poids de l'évaluation (voir AIEvalWeights)
+//
+// Dans le fichier de sortie, l'étiquette de chaque partie est le joueur tenu par la configuration A
+// et une partie nulle se termine avec l'état QUORIDOR_STATE_UNFINISHED.
+
+#include "core/core_settings.h"
+#include "core/quoridor_core.h"
+#include "core/quoridor_ai.h"
+#include "core/quoridor_record.h"
+#include "core/utils.h"
+
+#define SELFPLAY_MAX_THREADS 64
+#define SELFPLAY_MAX_PLIES 1000
+
+typedef struct SelfPlayEngine
+{
+    /// @brief Texte de la configuration, affiché dans les résultats.
+    char name[64];
+
+    /// @brief Paramètres des recherches.
+    AISearchParams params;
+
+    /// @brief Poids de l'évaluation, pointés par params.
+    AIEvalWeights weights;
+} SelfPlayEngine;
+
+typedef struct SelfPlay
+{
+    /// @brief Configurations A et B.
+    SelfPlayEngine engines[2];
+
+    int gameCount;
+    int threadCount;
+    int gridSize;
+    int wallCount;
+    int maxPlies;
+
+    /// @brief Position de départ de chaque paire de parties.
+    QuoridorRecordHeader *openings;
+
+    /// @brief Indice de la prochaine partie à jouer.
+    SDL_AtomicInt nextGame;
+
+    /// @brief Passe à 1 lorsque le SPRT est conclu : les threads ne commencent plus de partie.
+    SDL_AtomicInt stopFlag;
+
+    /// @brief Test séquentiel.
+    bool sprt;
+    double elo0, elo1, alpha, beta;
+
+    /// @brief Mutex protégeant les champs suivants.
+    SDL_Mutex *mutex;
+
+    /// @brief Fichier des parties (peut être NULL).
+    QuoridorRecordWriter *output;
+
+    /// @brief Victoires, nulles et défaites de la configuration A.
+    int wins, draws, losses;
+
+    /// @brief Nombre total de tours joués et nombre de coups illégaux.
+    long long plyCount;
+    int illegalCount;
+
+    /// @brief Nombre de parties terminées lors du dernier affichage.
+    int reportedCount;
+
+    Uint64 startCounter;
+} SelfPlay;
+
+/// @brief Lit une configuration de l'IA.
+static bool SelfPlayEngine_parse(SelfPlayEngine *self, const char *config)
+{
+    memset(self, 0, sizeof(SelfPlayEngine));
+    snprintf(self->name, sizeof(self->name), "%s", config);
+    self->weights = AIEvalWeights_default;
+    self->params.engine = AI_ENGINE_MINMAX;
+    self->params.threadCount = 1;
+    self->params.weights = &self->weights;
+
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "%s", config);
+
+    char *item = buffer;
+    while (item != NULL && *item != '\0')
+    {
+        char *next = strchr(item, ',');
+        if (next) *next++ = '\0';
+        char *value = strchr(item, '=');
+        if (value) *value++ = '\0';
+
+        if (strcmp(item, "mcts") == 0 && value == NULL)
+            self->params.engine = AI_ENGINE_MCTS;
+        else if (value == NULL)
+            return false;
+        else if (strcmp(item, "depth") == 0)
+            self->params.depth = atoi(value);
+        else if (strcmp(item, "time") == 0)
+            self->params.budgetMS = (Uint64)atoi(value);
+        else if (strcmp(item, "playouts") == 0)
+            self->params.playoutCount = atoi(value);
+        else if (strcmp(item, "path") == 0)
+            self->weights.pathDifference = (float)atof(value);
+        else if (strcmp(item, "length") == 0)
+            self->weights.pathLength = (float)atof(value);
+        else if (strcmp(item, "threat") == 0)
+            self->weights.threat = (float)atof(value);
+        else if (strcmp(item, "walls") == 0)
+            self->weights.wallCount = (float)atof(value);
+        else if (strcmp(item, "center") == 0)
+            self->weights.center = (float)atof(value);
+        else if (strcmp(item, "early") == 0)
+            self->weights.earlyWall = (float)atof(value);
+        else
+            return false;
+
+        item = next;
+    }
+
+    // Sans profondeur ni temps, la recherche min-max se fait à profondeur 2.
+    if (self->params.depth <= 0 && self->params.budgetMS == 0)
+        self->params.depth = 2;
+
+    return true;
+}
+
+/// @brief Convertit une proportion de points en écart d'Elo.
+static double SelfPlay_getElo(double score)
+{
+    score = fmin(fmax(score, 1e-6), 1.0 - 1e-6);
+    return -400.0 * log10(1.0 / score - 1.0);
+}
+
+/// @brief Convertit un écart d'Elo en proportion de points attendue.
+static double SelfPlay_getScore(double elo)
+{
+    return 1.0 / (1.0 + pow(10.0, -elo / 400.0));
+}
+
+/// @brief Renvoie la moyenne et la variance des points d'une partie de la configuration A.
+static void SelfPlay_getMoments(const SelfPlay *self, double *mean, double *variance)
+{
+    const double n = self->wins + self->draws + self->losses;
+    *mean = (self->wins + 0.5 * self->draws) / n;
+    *variance = (self->wins * pow(1.0 - *mean, 2.0)
+        + self->draws * pow(0.5 - *mean, 2.0)
+        + self->losses * pow(*mean, 2.0)) / n;
+}
+
+/// @brief Renvoie le logarithme du rapport de vraisemblance de H1 contre H0
+/// (approximation gaussienne du modèle victoire / nulle / défaite).
+static double SelfPlay_getLLR(const SelfPlay *self)
+{
+    const int n = self->wins + self->draws + self->losses;
+    double mean, variance;
+    SelfPlay_getMoments(self, &mean, &variance);
+    if (n == 0 || variance <= 0.0)
+        return 0.0;
+
+    const double s0 = SelfPlay_getScore(self->elo0);
+    const double s1 = SelfPlay_getScore(self->elo1);
+    return n * (s1 - s0) * (2.0 * mean - s0 - s1) / (2.0 * variance);
+}
+
+/// @brief Affiche les résultats courants. Le mutex doit être verrouillé.
+/// @return true si le SPRT est conclu.
+static bool SelfPlay_report(SelfPlay *self)
+{
+    const int n = self->wins + self->draws + self->losses;
+    double mean, variance;
+    SelfPlay_getMoments(self, &mean, &variance);
+
+    // Intervalle de confiance à 95 % sur la proportion de points.
+    const double margin = 1.96 * sqrt(variance / n);
+    const double elo = SelfPlay_getElo(mean);
+    const double eloMin = SelfPlay_getElo(mean - margin);
+    const double eloMax = SelfPlay_getElo(mean + margin);
+    const double seconds = (double)(SDL_GetPerformanceCounter() - self->startCounter) / SDL_GetPerformanceFrequency();
+
+    printf("Games %5d  W %5d  D %5d  L %5d  score %5.1f%%  Elo %+7.1f [%+.1f, %+.1f]  %.1f games/s",
+        n, self->wins, self->draws, self->losses, 100.0 * mean, elo, eloMin, eloMax, n / seconds);
+
+    bool concluded = false;
+    if (self->sprt)
+    {
+        const double llr = SelfPlay_getLLR(self);
+        const double lower = log(self->beta / (1.0 - self->alpha));
+        const double upper = log((1.0 - self->beta) / self->alpha);
+        printf("  LLR %+.2f [%+.2f, %+.2f]", llr, lower, upper);
+
+        if (llr >= upper || llr <= lower)
+        {
+            printf("\nSPRT: %s accepted (elo0 %+.1f, elo1 %+.1f)", (llr >= upper) ? "H1" : "H0", self->elo0, self->elo1);
+            concluded = true;
+        }
+    }
+    printf("\n");
+    fflush(stdout);
+
+    self->reportedCount = n;
+    return concluded;
+}
+
+/// @brief Enregistre une partie dans le fichier de sortie. Le mutex doit être verrouillé.
+static void SelfPlay_writeGame(
+    SelfPlay *self, const QuoridorRecordHeader *opening, int playerA, int finalState,
+    const QuoridorTurn *turns, int turnCount)
+{
+    QuoridorRecordHeader header = *opening;
+    header.tag = playerA;
+
+    QuoridorRecordWriter_beginGame(self->output, &header);
+    for (int k = 0; k < turnCount; k++)
+        QuoridorRecordWriter_addTurn(self->output, turns[k]);
+    QuoridorRecordWriter_endGame(self->output, finalState);
+}
+
+/// @brief Joue une partie.
+/// @param playerA Joueur tenu par la configuration A (l'autre est tenu par B).
+/// @return L'état final : QUORIDOR_STATE_P0_WON, QUORIDOR_STATE_P1_WON,
+/// ou QUORIDOR_STATE_UNFINISHED pour une partie nulle.
+static int SelfPlay_playGame(
+    SelfPlay *self, const QuoridorRecordHeader *opening, int playerA, void *aiData[2],
+    QuoridorTurn *turns, int *turnCount, bool *illegal)
+{
+    QuoridorCore core = { 0 };
+    QuoridorRecordHeader_setStartPosition(opening, &core);
+    AIData_reset(aiData[0]);
+    AIData_reset(aiData[1]);
+
+    *turnCount = 0;
+    *illegal = false;
+    while (core.state == QUORIDOR_STATE_IN_PROGRESS && *turnCount < self->maxPlies)
+    {
+        const int engineID = core.playerID ^ playerA;
+        const QuoridorTurn turn = QuoridorCore_computeTurnWithParams(
+            &core, &self->engines[engineID].params, aiData[engineID]);
+
+        // Un coup illégal (ou l'absence de coup) fait perdre la partie.
+        if (!QuoridorCore_canPlayTurn(&core, turn))
+        {
+            *illegal = true;
+            return (core.playerID == 0) ? QUORIDOR_STATE_P1_WON : QUORIDOR_STATE_P0_WON;
+        }
+
+        QuoridorCore_playTurn(&core, turn);
+        turns[(*turnCount)++] = turn;
+    }
+
+    return (core.state == QUORIDOR_STATE_IN_PROGRESS) ? QUORIDOR_STATE_UNFINISHED : core.state;
+}
+
+static int SelfPlay_worker(void *data)
+{
+    SelfPlay *self = (SelfPlay *)data;
+    QuoridorTurn turns[SELFPLAY_MAX_PLIES];
+    void *aiData[2] = { AIData_create(NULL), AIData_create(NULL) };
+
+    while (SDL_GetAtomicInt(&self->stopFlag) == 0)
+    {
+        const int game = SDL_AddAtomicInt(&self->nextGame, 1);
+        if (game >= self->gameCount)
+            break;
+
+        // Dans chaque paire, la configuration A joue une fois chaque couleur.
+        const QuoridorRecordHeader *opening = &self->openings[game / 2];
+        const int playerA = game & 1;
+        int turnCount;
+        bool illegal;
+        const int finalState = SelfPlay_playGame(self, opening, playerA, aiData, turns, &turnCount, &illegal);
+        const int winner = (finalState == QUORIDOR_STATE_P0_WON) ? 0 : (finalState == QUORIDOR_STATE_P1_WON) ? 1 : -1;
+
+        SDL_LockMutex(self->mutex);
+
+        if (winner < 0) self->draws++;
+        else if (winner == playerA) self->wins++;
+        else self->losses++;
+        self->plyCount += turnCount;
+        self->illegalCount += illegal;
+
+        if (self->output)
+            SelfPlay_writeGame(self, opening, playerA, finalState, turns, turnCount);
+
+        const int finishedCount = self->wins + self->draws + self->losses;
+        const int reportInterval = Int_max(1, self->gameCount / 50);
+        if (finishedCount - self->reportedCount >= reportInterval && SelfPlay_report(self))
+            SDL_SetAtomicInt(&self->stopFlag, 1);
+
+        SDL_UnlockMutex(self->mutex);
+    }
+
+    AIData_destroy(aiData[0]);
+    AIData_destroy(aiData[1]);
+    return 0;
+}
+
+/// @brief Tire l'ouverture de chaque paire de parties avec QuoridorCore_randomStart().
+/// Les ouvertures sont tirées avant le tournoi pour qu'une même graine donne les mêmes parties
+/// quel que soit le nombre de threads.
+static void SelfPlay_createOpenings(SelfPlay *self, bool randomStart, unsigned int seed)
+{
+    const int pairCount = (self->gameCount + 1) / 2;
+    self->openings = (QuoridorRecordHeader *)calloc(pairCount, sizeof(QuoridorRecordHeader));
+    AssertNew(self->openings);
+
+    srand(seed);
+    for (int p = 0; p < pairCount; p++)
+    {
+        QuoridorCore core = { 0 };
+        QuoridorCore_reset(&core, self->gridSize, self->wallCount, 0);
+        if (randomStart)
+            QuoridorCore_randomStart(&core);
+        QuoridorRecordHeader_init(&self->openings[p], &core, 0);
+    }
+}
+
+static void SelfPlay_printUsage(const char *program)
+{
+    printf("Usage: %s [-a <config>] [-b <config>] [--games <n>] [--threads <n>] [--grid <n>] [--walls <n>]\n"
+        "    [--max-plies <n>] [--seed <n>] [--no-random-start] [--sprt <elo0> <elo1> [alpha] [beta]]\n"
+        "    [--output <file>]\n"
+        "Config: comma-separated keys among depth=<n>, time=<ms>, mcts, playouts=<n>,\n"
+        "    path, length, threat, walls, center, early (evaluation weights), e.g. \"depth=3,threat=12\"\n",
+        program);
+}
+
+int main(int argc, char *argv[])
+{
+    SelfPlay self = { 0 };
+    self.gameCount = 1000;
+    self.threadCount = SDL_GetNumLogicalCPUCores();
+    self.gridSize = 9;
+    self.wallCount = 10;
+    self.maxPlies = 200;
+    self.alpha = 0.05;
+    self.beta = 0.05;
+
+    const char *configs[2] = { "depth=2", "depth=2" };
+    const char *outputPath = NULL;
+    unsigned int seed = 1;
+    bool randomStart = true;
+    bool valid = true;
+
+    for (int a = 1; a < argc && valid; a++)
+    {
+        const bool hasValue = (a + 1 < argc);
+        if (strcmp(argv[a], "-a") == 0 && hasValue)
+            configs[0] = argv[++a];
+        else if (strcmp(argv[a], "-b") == 0 && hasValue)
+            configs[1] = argv[++a];
+        else if (strcmp(argv[a], "--games") == 0 && hasValue)
+            self.gameCount = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--threads") == 0 && hasValue)
+            self.threadCount = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--grid") == 0 && hasValue)
+            self.gridSize = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--walls") == 0 && hasValue)
+            self.wallCount = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--max-plies") == 0 && hasValue)
+            self.maxPlies = atoi(argv[++a]);
+        else if (strcmp(argv[a], "--seed") == 0 && hasValue)
+            seed = (unsigned int)atoi(argv[++a]);
+        else if (strcmp(argv[a], "--no-random-start") == 0)
+            randomStart = false;
+        else if (strcmp(argv[a], "--output") == 0 && hasValue)
+            outputPath = argv[++a];
+        else if (strcmp(argv[a], "--sprt") == 0 && a + 2 < argc)
+        {
+            self.sprt = true;
+            self.elo0 = atof(argv[++a]);
+            self.elo1 = atof(argv[++a]);
+            if (a + 2 < argc && argv[a + 1][0] != '-' && argv[a + 2][0] != '-')
+            {
+                self.alpha = atof(argv[++a]);
+                self.beta = atof(argv[++a]);
+            }
+        }
+        else
+            valid = false;
+    }
+
+    valid = valid && (self.gridSize == 5 || self.gridSize == 7 || self.gridSize == 9)
+        && self.gameCount > 0 && self.wallCount >= 0 && self.wallCount <= 20
+        && self.maxPlies > 0 && self.maxPlies <= SELFPLAY_MAX_PLIES
+        && self.alpha > 0.0 && self.alpha < 1.0 && self.beta > 0.0 && self.beta < 1.0
+        && (!self.sprt || self.elo0 < self.elo1);
+    for (int e = 0; e < 2 && valid; e++)
+    {
+        if (!SelfPlayEngine_parse(&self.engines[e], configs[e]))
+        {
+            printf("Invalid config \"%s\"\n", configs[e]);
+            valid = false;
+        }
+    }
+    if (!valid)
+    {
+        SelfPlay_printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (outputPath)
+    {
+        self.output = QuoridorRecordWriter_create(outputPath, false);
+        if (self.output == NULL)
+        {
+            printf("Cannot open %s\n", outputPath);
+            return EXIT_FAILURE;
+        }
+    }
+
+    self.threadCount = Int_clamp(self.threadCount, 1, Int_min(SELFPLAY_MAX_THREADS, self.gameCount));
+    SelfPlay_createOpenings(&self, randomStart, seed);
+    self.mutex = SDL_CreateMutex();
+    AssertNew(self.mutex);
+
+    printf("A: %s\nB: %s\n%d games on %dx%d, %d walls, %d threads%s\n",
+        self.engines[0].name, self.engines[1].name, self.gameCount, self.gridSize, self.gridSize,
+        self.wallCount, self.threadCount, randomStart ? ", random start" : "");
+    fflush(stdout);
+
+    self.startCounter = SDL_GetPerformanceCounter();
+    SDL_Thread *threads[SELFPLAY_MAX_THREADS];
+    for (int t = 0; t < self.threadCount; t++)
+    {
+        threads[t] = SDL_CreateThread(SelfPlay_worker, "SelfPlay", &self);
+        AssertNew(threads[t]);
+    }
+    for (int t = 0; t < self.threadCount; t++)
+        SDL_WaitThread(threads[t], NULL);
+
+    const int playedCount = self.wins + self.draws + self.losses;
+    if (playedCount > self.reportedCount)
+        SelfPlay_report(&self);
+    printf("Average length: %.1f turns", (double)self.plyCount / Int_max(1, playedCount));
+    if (self.illegalCount > 0)
+        printf(", %d games lost on an illegal turn", self.illegalCount);
+    printf("\n");
+
+    QuoridorRecordWriter_destroy(self.output);
+    SDL_DestroyMutex(self.mutex);
+    free(self.openings);
+
+    return EXIT_SUCCESS;
+}